@@ -0,0 +1,129 @@
+//-----------------------------------------------------
+//Foto del estado de todos los cuerpos del mundo en un
+//arreglo plano: transformacion, velocidades y si esta
+//despierto y habilitado. Restore() lo vuelve a escribir
+//sobre los mismos cuerpos, sin destruir ni recrear el
+//mundo, asi que reiniciar una escena cuesta un recorrido
+//de la lista de cuerpos
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <algorithm>
+#include <vector>
+
+enum BodyStateFlags
+{
+	BodyState_Awake = 1 << 0,
+	BodyState_Enabled = 1 << 1
+};
+
+// Estado de un cuerpo, 40 bytes con el puntero
+struct BodyState
+{
+	b2Body* body;
+	b2Vec2 position;
+	float angle;
+	b2Vec2 linearVelocity;
+	float angularVelocity;
+	uint32 flags;			// BodyStateFlags
+};
+
+class WorldSnapshot
+{
+private:
+	std::vector<BodyState> states;	// En el orden de la lista del mundo
+	std::vector<b2Body*> sorted;	// Los mismos cuerpos ordenados, para buscarlos
+
+	bool Contains(b2Body* body) const
+	{
+		return std::binary_search(sorted.begin(), sorted.end(), body);
+	}
+
+public:
+	// Guarda el estado de todos los cuerpos. Se llama con el mundo
+	// desbloqueado (fuera del Step)
+	void Capture(b2World* world)
+	{
+		states.clear();
+		sorted.clear();
+		states.reserve(world->GetBodyCount());
+		sorted.reserve(world->GetBodyCount());
+		for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+		{
+			BodyState state;
+			state.body = body;
+			state.position = body->GetPosition();
+			state.angle = body->GetAngle();
+			state.linearVelocity = body->GetLinearVelocity();
+			state.angularVelocity = body->GetAngularVelocity();
+			state.flags = (body->IsAwake() ? BodyState_Awake : 0) | (body->IsEnabled() ? BodyState_Enabled : 0);
+			states.push_back(state);
+			sorted.push_back(body);
+		}
+		std::sort(sorted.begin(), sorted.end());
+	}
+
+	// Escribe el estado guardado en los mismos cuerpos. Los creados despues
+	// de Capture() no se tocan y se devuelven en created (si no es nullptr)
+	// para que quien los creo decida si destruirlos. Si falta alguno de los
+	// cuerpos guardados no escribe nada y devuelve false. Un cuerpo
+	// destruido cuya memoria reuso otro no se puede detectar: los cuerpos
+	// de la foto no se tienen que destruir mientras se use
+	bool Restore(b2World* world, std::vector<b2Body*>* created = nullptr) const
+	{
+		if (world->IsLocked())
+			return false;
+
+		if (created)
+			created->clear();
+		size_t found = 0;
+		for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+		{
+			if (Contains(body))
+				found++;
+			else if (created)
+				created->push_back(body);
+		}
+		if (found != states.size())
+			return false;
+
+		for (const BodyState& state : states)
+		{
+			b2Body* body = state.body;
+			bool enabled = (state.flags & BodyState_Enabled) != 0;
+			if (body->IsEnabled() != enabled)
+				body->SetEnabled(enabled);
+
+			// Solo se mueve lo que se movio: SetTransform actualiza el
+			// broadphase y los estaticos son la mayoria en muchas escenas
+			const b2Vec2& position = body->GetPosition();
+			if (position.x != state.position.x || position.y != state.position.y || body->GetAngle() != state.angle)
+				body->SetTransform(state.position, state.angle);
+
+			if (state.flags & BodyState_Awake)
+			{
+				body->SetAwake(true);
+				body->SetLinearVelocity(state.linearVelocity);
+				body->SetAngularVelocity(state.angularVelocity);
+			}
+			else
+			{
+				// Dormir un cuerpo pone en cero sus velocidades y fuerzas
+				body->SetAwake(false);
+			}
+		}
+		return true;
+	}
+
+	void Clear()
+	{
+		states.clear();
+		sorted.clear();
+	}
+
+	bool IsEmpty() const { return states.empty(); }
+	int GetBodyCount() const { return (int)states.size(); }
+	size_t GetByteSize() const { return states.size() * (sizeof(BodyState) + sizeof(b2Body*)); }
+	const std::vector<BodyState>& GetStates() const { return states; }
+};
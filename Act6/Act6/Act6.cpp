@@ -1,11 +1,34 @@
 #include "Game.h" // Incluye el archivo de encabezado de la clase Game
 #include <tchar.h> // Incluye la biblioteca de caracteres de Windows
+#include <cstdlib>
+#include <string>
+
+// Argumento de la lnea de comandos como std::string (las rutas de escena son ASCII)
+static std::string ToString(const _TCHAR* arg)
+{
+    std::string text;
+    for (; *arg; ++arg)
+        text += (char)*arg;
+    return text;
+}
 
 int _tmain(int argc, _TCHAR* argv[])
 {
     // Crear el objeto de la clase Game
     Game* Juego;
-    Juego = new Game(800, 600, "Esqueleto de Aplicacin - MAVII");
+    // Opcional: archivo de escena (texto o binario) en vez del armado por cdigo,
+    // o una escena de estrs generada: --estres <tipo> [cuerpos] [semilla]
+    std::string escena = argc > 1 ? ToString(argv[1]) : "";
+    StressParams estres;
+    if (escena == "--estres" && argc > 2)
+    {
+        if (!StressScenes::FromName(ToString(argv[2]).c_str(), estres.kind))
+            estres.kind = Stress_Pyramid;
+        estres.bodyCount = argc > 3 ? std::atoi(ToString(argv[3]).c_str()) : 1000;
+        estres.seed = argc > 4 ? (uint32)std::atoi(ToString(argv[4]).c_str()) : 1;
+        escena = "";
+    }
+    Juego = new Game(800, 600, "Esqueleto de Aplicacin - MAVII", escena, estres);
     Juego->Loop(); // Ejecutar el bucle principal del juego
 
     return 0; // Retorna 0 indicando que el programa se ha ejecutado correctamente
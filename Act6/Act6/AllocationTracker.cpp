@@ -0,0 +1,273 @@
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+// Totales de un hilo, en su propia lnea de cache. Solo los escribe el
+// hilo dueo, as que sumar no necesita una operacin atmica de
+// lectura-escritura: son atmicos para que EndFrame los lea sin cortes.
+// Inicializacin constante: el operator new puede correr antes que
+// cualquier constructor esttico
+struct alignas(64) ThreadCounts
+{
+    std::atomic<long long> allocations[Alloc_Count];
+    std::atomic<long long> bytes[Alloc_Count];
+    std::atomic<long long> frees;
+    std::atomic<long long> freedBytes;
+    std::atomic<long long> hot;
+};
+
+// Un lugar por hilo que alguna vez asign. Los lugares no se reciclan
+// (los hilos de los pools viven todo el programa); si se acaban, los
+// hilos que sobran comparten uno con sumas atmicas
+static const int MaxThreads = 256;
+static ThreadCounts threadCounts[MaxThreads];
+static ThreadCounts sharedCounts;
+static std::atomic<int> threadCountsUsed;
+
+// Marcadas del frame actual: se escriben desde cualquier hilo sin asignar
+static HotAllocation hotRecords[AllocationTracker::MaxHotRecords];
+static std::atomic<int> hotRecordCount;
+
+// Estado del frame, solo del hilo que llama a BeginFrame/EndFrame
+static FrameAllocations frameStart;
+static bool expectZero = false;
+static long long failedFrames = 0;
+
+// Categora, seccin caliente y contadores de cada hilo
+static thread_local AllocCategory currentCategory = Alloc_Game;
+static thread_local const char* currentHotSection = nullptr;
+static thread_local ThreadCounts* currentCounts = nullptr;
+
+static ThreadCounts& GetThreadCounts()
+{
+    if (!currentCounts)
+    {
+        int index = threadCountsUsed.fetch_add(1, std::memory_order_relaxed);
+        currentCounts = index < MaxThreads ? &threadCounts[index] : &sharedCounts;
+    }
+    return *currentCounts;
+}
+
+static void Add(ThreadCounts& counts, std::atomic<long long>& counter, long long value)
+{
+    if (&counts == &sharedCounts)
+        counter.fetch_add(value, std::memory_order_relaxed);
+    else
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// Suma de los contadores de todos los hilos desde el inicio del programa
+static FrameAllocations Sum()
+{
+    FrameAllocations sum = {};
+    int used = threadCountsUsed.load(std::memory_order_relaxed);
+    int count = used < MaxThreads ? used : MaxThreads;
+    for (int t = 0; t <= count; ++t)
+    {
+        const ThreadCounts& counts = t < count ? threadCounts[t] : sharedCounts;
+        for (int i = 0; i < Alloc_Count; ++i)
+        {
+            sum.categories[i].allocations += counts.allocations[i].load(std::memory_order_relaxed);
+            sum.categories[i].bytes += counts.bytes[i].load(std::memory_order_relaxed);
+        }
+        sum.frees += counts.frees.load(std::memory_order_relaxed);
+        sum.freedBytes += counts.freedBytes.load(std::memory_order_relaxed);
+        sum.hotAllocations += counts.hot.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+// Tamao real del bloque que devolvi malloc. No se guarda un encabezado
+// propio porque los DLL de SFML asignan con su new y a veces el juego
+// libera esos bloques con el suyo (los destructores inline de sf::String)
+static size_t BlockSize(void* memory)
+{
+#ifdef _WIN32
+    return _msize(memory);
+#else
+    return malloc_usable_size(memory);
+#endif
+}
+
+long long FrameAllocations::GetAllocations() const
+{
+    long long total = 0;
+    for (int i = 0; i < Alloc_Count; ++i)
+        total += categories[i].allocations;
+    return total;
+}
+
+long long FrameAllocations::GetBytes() const
+{
+    long long total = 0;
+    for (int i = 0; i < Alloc_Count; ++i)
+        total += categories[i].bytes;
+    return total;
+}
+
+void* AllocationTracker::Allocate(size_t size, AllocCategory category)
+{
+    void* memory = std::malloc(size);
+    if (!memory)
+        return nullptr;
+
+    ThreadCounts& counts = GetThreadCounts();
+    Add(counts, counts.allocations[category], 1);
+    Add(counts, counts.bytes[category], (long long)size);
+
+    // Dentro de una seccin caliente: se guarda quin fue, si hay lugar
+    if (currentHotSection)
+    {
+        Add(counts, counts.hot, 1);
+        int index = hotRecordCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < MaxHotRecords)
+        {
+            hotRecords[index].section = currentHotSection;
+            hotRecords[index].category = category;
+            hotRecords[index].size = size;
+        }
+    }
+    return memory;
+}
+
+void AllocationTracker::Free(void* memory)
+{
+    if (!memory)
+        return;
+    ThreadCounts& counts = GetThreadCounts();
+    Add(counts, counts.frees, 1);
+    Add(counts, counts.freedBytes, (long long)BlockSize(memory));
+    std::free(memory);
+}
+
+void AllocationTracker::BeginFrame()
+{
+    frameStart = Sum();
+    hotRecordCount.store(0, std::memory_order_relaxed);
+}
+
+FrameAllocations AllocationTracker::EndFrame()
+{
+    FrameAllocations frame = Sum();
+    for (int i = 0; i < Alloc_Count; ++i)
+    {
+        frame.categories[i].allocations -= frameStart.categories[i].allocations;
+        frame.categories[i].bytes -= frameStart.categories[i].bytes;
+    }
+    frame.frees -= frameStart.frees;
+    frame.freedBytes -= frameStart.freedBytes;
+    frame.hotAllocations -= frameStart.hotAllocations;
+
+    if (expectZero && frame.GetAllocations() > 0)
+    {
+        failedFrames++;
+        std::printf("Frame con asignaciones (se esperaban cero):\n");
+        Print(frame);
+    }
+    return frame;
+}
+
+void AllocationTracker::ExpectZeroAllocations(bool expect)
+{
+    expectZero = expect;
+}
+
+long long AllocationTracker::GetFailedFrames()
+{
+    return failedFrames;
+}
+
+AllocCounts AllocationTracker::GetTotals(AllocCategory category)
+{
+    return Sum().categories[category];
+}
+
+long long AllocationTracker::GetFrees()
+{
+    return Sum().frees;
+}
+
+int AllocationTracker::GetHotAllocations(HotAllocation* out, int maxCount)
+{
+    int count = hotRecordCount.load(std::memory_order_relaxed);
+    if (count > MaxHotRecords)
+        count = MaxHotRecords;
+    if (count > maxCount)
+        count = maxCount;
+    for (int i = 0; i < count; ++i)
+        out[i] = hotRecords[i];
+    return count;
+}
+
+const char* AllocationTracker::GetCategoryName(AllocCategory category)
+{
+    static const char* names[Alloc_Count] = { "juego", "box2d", "formas", "dibujo", "disparos" };
+    return (category >= 0 && category < Alloc_Count) ? names[category] : "desconocida";
+}
+
+// Una lnea por categora que asign, las liberaciones y las marcadas
+void AllocationTracker::Print(const FrameAllocations& frame)
+{
+    for (int i = 0; i < Alloc_Count; ++i)
+    {
+        const AllocCounts& counts = frame.categories[i];
+        if (counts.allocations > 0)
+            std::printf("  %-9s %6lld asignaciones %9lld bytes\n", GetCategoryName((AllocCategory)i), counts.allocations, counts.bytes);
+    }
+    if (frame.frees > 0)
+        std::printf("  %6lld liberaciones %9lld bytes\n", frame.frees, frame.freedBytes);
+
+    HotAllocation records[MaxHotRecords];
+    int count = GetHotAllocations(records, MaxHotRecords);
+    for (int i = 0; i < count; ++i)
+        std::printf("  en %s: %zu bytes (%s)\n", records[i].section, records[i].size, GetCategoryName(records[i].category));
+    if (frame.hotAllocations > count)
+        std::printf("  ... y %lld mas en secciones calientes\n", frame.hotAllocations - count);
+}
+
+// Constructor de la clase AllocationScope
+AllocationScope::AllocationScope(AllocCategory category)
+{
+    previous = currentCategory;
+    currentCategory = category;
+}
+
+AllocationScope::~AllocationScope()
+{
+    currentCategory = previous;
+}
+
+// Constructor de la clase HotSection
+HotSection::HotSection(const char* name)
+{
+    previous = currentHotSection;
+    currentHotSection = name;
+}
+
+HotSection::~HotSection()
+{
+    currentHotSection = previous;
+}
+
+// Reemplazo global: las versiones nothrow y de arreglos de la biblioteca
+// estndar terminan llamando a estas
+void* operator new(size_t size)
+{
+    void* memory = AllocationTracker::Allocate(size > 0 ? size : 1, currentCategory);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    AllocationTracker::Free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    AllocationTracker::Free(memory);
+}
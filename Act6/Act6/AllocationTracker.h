@@ -0,0 +1,108 @@
+//-----------------------------------------------------
+//Contador de asignaciones de memoria. Reemplaza el
+//operator new/delete global y, si Box2D se compila con
+//b2_user_settings.h, tambien b2Alloc/b2Free. Cuenta
+//asignaciones y bytes por frame y por categoria (la
+//del AllocationScope activo en el hilo) y marca las
+//que caen dentro de una HotSection. Con el modo de
+//cero asignaciones cada frame que asigna es un error
+//-----------------------------------------------------
+
+#pragma once
+#include <cstddef>
+
+// Categoria del lugar que asigna. Las de b2Alloc van siempre a Alloc_Box2D
+enum AllocCategory
+{
+	Alloc_Game = 0,		// Todo lo que no tiene categoria
+	Alloc_Box2D,		// b2Alloc: cuerpos, fixtures, contactos, arbol
+	Alloc_Shapes,		// Formas que arma Box2DHelper
+	Alloc_Drawing,		// Dibujo con SFML
+	Alloc_Projectiles,	// Disparos del caon
+	Alloc_Count
+};
+
+struct AllocCounts
+{
+	long long allocations;
+	long long bytes;		// Pedidos
+};
+
+// Diferencia entre BeginFrame y EndFrame. Las liberaciones no tienen
+// categoria: el bloque no guarda quien lo pidio
+struct FrameAllocations
+{
+	AllocCounts categories[Alloc_Count];
+	long long frees;
+	long long freedBytes;		// Tamao real del bloque, puede pasar al pedido
+	long long hotAllocations;	// Asignaciones dentro de una HotSection
+
+	long long GetAllocations() const;
+	long long GetBytes() const;
+};
+
+// Asignacion marcada dentro de una seccion caliente
+struct HotAllocation
+{
+	const char* section;
+	AllocCategory category;
+	size_t size;
+};
+
+class AllocationTracker
+{
+public:
+	static const int MaxHotRecords = 32;	// Marcadas que se guardan por frame
+
+	// Lo llaman el operator new global y b2Alloc. No asignan nada ellos mismos
+	static void* Allocate(size_t size, AllocCategory category);
+	static void Free(void* memory);
+
+	// Frame de la aplicacion, siempre desde el mismo hilo. Cada hilo cuenta
+	// en sus propios contadores y EndFrame suma lo asignado en el medio por
+	// todos los hilos
+	static void BeginFrame();
+	static FrameAllocations EndFrame();
+
+	// Modo de cero asignaciones para pruebas: EndFrame imprime cada frame
+	// que asigno algo y lo cuenta como fallido
+	static void ExpectZeroAllocations(bool expect);
+	static long long GetFailedFrames();
+
+	// Totales desde el inicio del programa
+	static AllocCounts GetTotals(AllocCategory category);
+	static long long GetFrees();
+
+	// Marcadas desde el ultimo BeginFrame (hasta MaxHotRecords)
+	static int GetHotAllocations(HotAllocation* out, int maxCount);
+
+	static const char* GetCategoryName(AllocCategory category);
+	static void Print(const FrameAllocations& frame);
+};
+
+// Mientras vive, lo que asigna este hilo se cuenta en la categoria dada
+class AllocationScope
+{
+private:
+	AllocCategory previous;
+
+public:
+	explicit AllocationScope(AllocCategory category);
+	~AllocationScope();
+	AllocationScope(const AllocationScope&) = delete;
+	AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+// Mientras vive, cualquier asignacion de este hilo se marca con el nombre
+// de la seccion. El nombre tiene que ser un literal
+class HotSection
+{
+private:
+	const char* previous;
+
+public:
+	explicit HotSection(const char* name);
+	~HotSection();
+	HotSection(const HotSection&) = delete;
+	HotSection& operator=(const HotSection&) = delete;
+};
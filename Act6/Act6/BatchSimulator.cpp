@@ -0,0 +1,103 @@
+#include "BatchSimulator.h"
+#include <chrono>
+
+// Velocidad vertical minima para contar un rebote (descarta el temblor de
+// un cuerpo apoyado)
+static const float bounceSpeed = 0.5f;
+
+// Box2D arma su tabla de funciones de contacto la primera vez que crea
+// un contacto, sin sincronizar. Se fuerza ac, en un solo hilo, antes de
+// que los mundos del lote choquen en paralelo
+static void InitializeContactTable()
+{
+    static bool initialized = false;
+    if (initialized)
+        return;
+    initialized = true;
+
+    b2World phyWorld(b2Vec2(0.0f, 0.0f));
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_dynamicBody;
+    b2CircleShape circle;
+    circle.m_radius = 1.0f;
+    b2Body* first = phyWorld.CreateBody(&bodyDef);
+    first->CreateFixture(&circle, 1.0f);
+    b2Body* second = phyWorld.CreateBody(&bodyDef);
+    second->CreateFixture(&circle, 1.0f);
+    phyWorld.Step(1.0f / 60.0f, 1, 1);
+}
+
+// Constructor de la clase BatchSimulator
+BatchSimulator::BatchSimulator(ThreadPool* pool, int minChunk)
+{
+    this->pool = pool;
+    this->minChunk = minChunk > 0 ? minChunk : 1;
+    InitializeContactTable();
+}
+
+void BatchSimulator::RunJob(const BatchSetup& setup, int job, int steps, float timeStep, bool stopWhenAsleep, BatchResult& result)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // En el heap: b2World lleva adentro la pila de 100 KB de Box2D
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    b2Body* body = setup(phyWorld, job);
+
+    // Se acumula en una copia local y se escribe la fila una sola vez,
+    // para que los hilos no se pisen las lineas de cache de la tabla
+    BatchResult local;
+    local.startPosition = body ? body->GetPosition() : b2Vec2(0.0f, 0.0f);
+    local.maxSpeed = 0.0f;
+    local.sleepTime = -1.0f;
+    local.pathLength = 0.0f;
+    local.bounces = 0;
+    local.steps = 0;
+    b2Vec2 lastPosition = local.startPosition;
+    float lastVerticalSpeed = body ? body->GetLinearVelocity().y : 0.0f;
+    for (int i = 0; i < steps; ++i)
+    {
+        phyWorld->Step(timeStep, 8, 8);
+        local.steps++;
+        if (!body)
+            continue;
+
+        b2Vec2 velocity = body->GetLinearVelocity();
+        local.maxSpeed = b2Max(local.maxSpeed, velocity.Length());
+        local.pathLength += (body->GetPosition() - lastPosition).Length();
+        lastPosition = body->GetPosition();
+        if (lastVerticalSpeed > bounceSpeed && velocity.y < -bounceSpeed)
+            local.bounces++;
+        lastVerticalSpeed = velocity.y;
+        if (!body->IsAwake())
+        {
+            // Cuenta la primera vez que se duerme aunque se siga simulando
+            if (local.sleepTime < 0.0f)
+                local.sleepTime = local.steps * timeStep;
+            if (stopWhenAsleep)
+                break;
+        }
+    }
+    local.endPosition = body ? body->GetPosition() : b2Vec2(0.0f, 0.0f);
+    local.endAngle = body ? body->GetAngle() : 0.0f;
+    delete phyWorld;
+
+    local.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result = local;
+}
+
+void BatchSimulator::Run(int jobCount, const BatchSetup& setup, int steps, float timeStep, bool stopWhenAsleep)
+{
+    // La tabla se reserva entera antes de repartir: cada trabajo escribe
+    // solo su fila y nadie agranda el vector mientras corren los hilos
+    results.assign(jobCount, BatchResult());
+
+    auto runRange = [&](int begin, int end) {
+        for (int job = begin; job < end; ++job)
+            RunJob(setup, job, steps, timeStep, stopWhenAsleep, results[job]);
+    };
+
+    if (pool)
+        pool->ParallelFor(jobCount, minChunk, runRange);
+    else
+        runRange(0, jobCount);
+}
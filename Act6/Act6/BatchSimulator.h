@@ -0,0 +1,53 @@
+//-----------------------------------------------------
+//Simulacion en lote de muchos mundos independientes,
+//uno por trabajo, repartidos en el pool de hilos. Cada
+//trabajo crea su propio b2World, lo arma, lo simula y
+//escribe una fila de la tabla de resultados, reservada
+//antes de empezar: los hilos no comparten nada mas
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <functional>
+#include <vector>
+#include "ThreadPool.h"
+
+// Resultado de un mundo, medido sobre el cuerpo que devuelve el armado
+struct BatchResult
+{
+	b2Vec2 startPosition;
+	b2Vec2 endPosition;
+	float endAngle;
+	float maxSpeed;			// Mayor velocidad lineal durante la simulacion
+	float sleepTime;		// Segundos hasta que se durmio, -1 si no llego
+	float pathLength;		// Distancia recorrida sumando cada paso
+	int bounces;			// Veces que iba hacia abajo (y+) y paso a subir
+	int steps;				// Pasos simulados
+	double elapsedMs;		// Tiempo de armado y simulacion de este mundo
+};
+
+// Arma el mundo del trabajo job y devuelve el cuerpo a seguir. Corre en
+// cualquier hilo del pool: solo puede tocar el mundo que recibe
+typedef std::function<b2Body*(b2World* phyWorld, int job)> BatchSetup;
+
+class BatchSimulator
+{
+private:
+	ThreadPool* pool;		// nullptr: todo en el hilo que llama
+	std::vector<BatchResult> results;
+	int minChunk;
+
+	static void RunJob(const BatchSetup& setup, int job, int steps, float timeStep, bool stopWhenAsleep, BatchResult& result);
+
+public:
+	// minChunk: mundos minimos por bloque del pool
+	BatchSimulator(ThreadPool* pool, int minChunk = 1);
+
+	// Corre jobCount mundos de steps pasos. Con stopWhenAsleep cada mundo
+	// termina cuando su cuerpo se duerme. Bloquea hasta que terminan todos
+	void Run(int jobCount, const BatchSetup& setup, int steps, float timeStep, bool stopWhenAsleep);
+
+	int GetCount() const { return (int)results.size(); }
+	const BatchResult& GetResult(int job) const { return results[job]; }
+	const std::vector<BatchResult>& GetResults() const { return results; }
+};
@@ -1,5 +1,8 @@
 #include <Box2D/Box2D.h>
 #pragma once
+#include "AllocationTracker.h"
+#include "CollisionLayers.h"
+#include "PolygonDecomposer.h"
 
 class Box2DHelper
 {
@@ -61,7 +64,7 @@ public:
 	//-------------------------------------------------------------
 	static b2FixtureDef CreateRectangularFixtureDef(float sizeX, float sizeY, float density, float friction, float restitution)
 	{
-
+		AllocationScope scope(Alloc_Shapes);
 		b2PolygonShape* box = new b2PolygonShape();
 
 		box->SetAsBox(sizeX / 2.0f, sizeY / 2.0f, b2Vec2(0.0f, 0.0f), 0.0f);
@@ -80,6 +83,7 @@ public:
 	//-------------------------------------------------------------
 	static b2FixtureDef CreateCircularFixtureDef(float radius, float density, float friction, float restitution)
 	{
+		AllocationScope scope(Alloc_Shapes);
 		b2CircleShape* circle = new b2CircleShape();
 		circle->m_p = b2Vec2(0.0f, 0.0f);
 		circle->m_radius = radius;
@@ -98,6 +102,7 @@ public:
 	//-------------------------------------------------------------
 	static b2FixtureDef CreatePolyFixtureDef(b2Vec2* v, int n, float density, float friction, float restitution)
 	{
+		AllocationScope scope(Alloc_Shapes);
 		b2PolygonShape* poly = new b2PolygonShape();
 		poly->Set(v, n);
 
@@ -110,6 +115,40 @@ public:
 		return fixtureDef;
 	}
 
+	//-------------------------------------------------------------
+	// Agrega al body un poligono simple cualquiera (concavo o con mas
+	// de b2_maxPolygonVertices vertices) como varias fixtures convexas.
+	// La descomposicion queda en cache, los spawns repetidos no la pagan.
+	// Devuelve la cantidad de fixtures creadas: 0 si el poligono se cruza
+	// a si mismo o no tiene 3 puntos distintos, y no se crea nada
+	//-------------------------------------------------------------
+	static int CreatePolyFixtures(b2Body* body, b2Vec2* v, int n, float density, float friction, float restitution)
+	{
+		const std::vector<ConvexPiece>& pieces = PolygonDecomposer::Decompose(v, n);
+
+		// Poligono invalido: se rechaza como en SceneFile. Pasarlo a
+		// b2PolygonShape::Set lo recortaria a 8 puntos o lo haria una caja
+		if (pieces.empty())
+			return 0;
+
+		// CreateFixture clona la shape, asi que alcanza con una en el stack
+		b2PolygonShape poly;
+		b2FixtureDef fixtureDef;
+		fixtureDef.shape = &poly;
+		fixtureDef.density = density;
+		fixtureDef.friction = friction;
+		fixtureDef.restitution = restitution;
+		fixtureDef.filter = CollisionLayers::MakeFilter(CollisionLayers::DefaultLayer(body->GetType()));
+
+		for (const ConvexPiece& piece : pieces)
+		{
+			poly.Set(piece.vertices, piece.count);
+			body->CreateFixture(&fixtureDef);
+		}
+
+		return (int)pieces.size();
+	}
+
 	//-------------------------------------------------------------
 	// Crea un fixture triangular (tringulo equiltero)
 	//-------------------------------------------------------------
@@ -133,6 +172,7 @@ public:
 	{
 		b2Body* body = CreateDynamicBody(phyWorld);
 		b2FixtureDef box = CreateRectangularFixtureDef(sizeX, sizeY, density, friction, restitution);
+		box.filter = CollisionLayers::MakeFilter(Layer_Enemy);
 		body->CreateFixture(&box);
 
 		return body;
@@ -145,6 +185,7 @@ public:
 	{
 		b2Body* body = CreateKinematicBody(phyWorld);
 		b2FixtureDef box = CreateRectangularFixtureDef(sizeX, sizeY, 0.0f, 0.0f, 0.0f);
+		box.filter = CollisionLayers::MakeFilter(Layer_Player);
 		body->CreateFixture(&box);
 
 		return body;
@@ -157,6 +198,7 @@ public:
 	{
 		b2Body* body = CreateStaticBody(phyWorld);
 		b2FixtureDef box = CreateRectangularFixtureDef(sizeX, sizeY, 0.0f, 0.0f, 0.0f);
+		box.filter = CollisionLayers::MakeFilter(Layer_StaticWorld);
 		body->CreateFixture(&box);
 
 		return body;
@@ -169,6 +211,7 @@ public:
 	{
 		b2Body* body = CreateDynamicBody(phyWorld);
 		b2FixtureDef cir = CreateCircularFixtureDef(radius, density, friction, restitution);
+		cir.filter = CollisionLayers::MakeFilter(Layer_Enemy);
 		body->CreateFixture(&cir);
 
 		return body;
@@ -181,6 +224,7 @@ public:
 	{
 		b2Body* body = CreateKinematicBody(phyWorld);
 		b2FixtureDef cir = CreateCircularFixtureDef(radius, 0.0f, 0.0f, 0.0f);
+		cir.filter = CollisionLayers::MakeFilter(Layer_Player);
 		body->CreateFixture(&cir);
 
 		return body;
@@ -193,6 +237,7 @@ public:
 	{
 		b2Body* body = CreateStaticBody(phyWorld);
 		b2FixtureDef cir = CreateCircularFixtureDef(radius, 0.0f, 0.0f, 0.0f);
+		cir.filter = CollisionLayers::MakeFilter(Layer_StaticWorld);
 		body->CreateFixture(&cir);
 
 		return body;
@@ -205,6 +250,7 @@ public:
 	{
 		b2Body* body = CreateDynamicBody(phyWorld);
 		b2FixtureDef tri = CreateTriangularFixtureDef(center, h, density, friction, restitution);
+		tri.filter = CollisionLayers::MakeFilter(Layer_Enemy);
 		body->CreateFixture(&tri);
 
 		return body;
@@ -217,6 +263,7 @@ public:
 	{
 		b2Body* body = CreateKinematicBody(phyWorld);
 		b2FixtureDef tri = CreateTriangularFixtureDef(center, h, 0.0f, 0.0f, 0.0f);
+		tri.filter = CollisionLayers::MakeFilter(Layer_Player);
 		body->CreateFixture(&tri);
 
 		return body;
@@ -229,43 +276,41 @@ public:
 	{
 		b2Body* body = CreateStaticBody(phyWorld);
 		b2FixtureDef tri = CreateTriangularFixtureDef(center, h, 0.0f, 0.0f, 0.0f);
+		tri.filter = CollisionLayers::MakeFilter(Layer_StaticWorld);
 		body->CreateFixture(&tri);
 
 		return body;
 	}
 
 	//-------------------------------------------------------------
-	// Crea un body dinmico con un fixture poligonal 
+	// Crea un body dinmico con un polgono (varias fixtures si es cncavo)
 	//-------------------------------------------------------------
 	static b2Body* CreatePolyDynamicBody(b2World* phyWorld, b2Vec2* v, int n, float density, float friction, float restitution)
 	{
 		b2Body* body = CreateDynamicBody(phyWorld);
-		b2FixtureDef tri = CreatePolyFixtureDef(v, n, density, friction, restitution);
-		body->CreateFixture(&tri);
+		CreatePolyFixtures(body, v, n, density, friction, restitution);
 
 		return body;
 	}
 
 	//-------------------------------------------------------------
-	// Crea un body cinemtico con un fixture poligonal 
+	// Crea un body cinemtico con un polgono (varias fixtures si es cncavo)
 	//-------------------------------------------------------------
 	static b2Body* CreatePolyKinematicBody(b2World* phyWorld, b2Vec2* v, int n)
 	{
 		b2Body* body = CreateKinematicBody(phyWorld);
-		b2FixtureDef tri = CreatePolyFixtureDef(v, n, 0.0f, 0.0f, 0.0f);
-		body->CreateFixture(&tri);
+		CreatePolyFixtures(body, v, n, 0.0f, 0.0f, 0.0f);
 
 		return body;
 	}
 
 	//-------------------------------------------------------------
-	// Crea un body esttico con un fixture poligonal
+	// Crea un body esttico con un polgono (varias fixtures si es cncavo)
 	//-------------------------------------------------------------
 	static b2Body* CreatePolyStaticBody(b2World* phyWorld, b2Vec2* v, int n)
 	{
-		b2Body* body = CreateDynamicBody(phyWorld);
-		b2FixtureDef tri = CreatePolyFixtureDef(v, n, 0.0f, 0.0f, 0.0f);
-		body->CreateFixture(&tri);
+		b2Body* body = CreateStaticBody(phyWorld);
+		CreatePolyFixtures(body, v, n, 0.0f, 0.0f, 0.0f);
 
 		return body;
 	}
@@ -0,0 +1,131 @@
+#include "CollisionLayers.h"
+
+static void SetBits(uint16* masks, CollisionLayer a, CollisionLayer b, bool collide)
+{
+    if (collide)
+    {
+        masks[a] |= CollisionLayers::Category(b);
+        masks[b] |= CollisionLayers::Category(a);
+    }
+    else
+    {
+        masks[a] &= (uint16)~CollisionLayers::Category(b);
+        masks[b] &= (uint16)~CollisionLayers::Category(a);
+    }
+}
+
+// Tabla por defecto:
+// - las balas no chocan entre si ni con el caon que las dispara
+// - los sensores no se detectan entre ellos
+// - los estaticos nunca generan pares entre si (Box2D ya los descarta)
+static bool FillDefaults(uint16* masks)
+{
+    for (int i = 0; i < Layer_Count; ++i)
+        masks[i] = 0;
+
+    SetBits(masks, Layer_StaticWorld, Layer_Player, true);
+    SetBits(masks, Layer_StaticWorld, Layer_Projectile, true);
+    SetBits(masks, Layer_StaticWorld, Layer_Enemy, true);
+    SetBits(masks, Layer_Player, Layer_Enemy, true);
+    SetBits(masks, Layer_Player, Layer_Sensor, true);
+    SetBits(masks, Layer_Projectile, Layer_Enemy, true);
+    SetBits(masks, Layer_Projectile, Layer_Sensor, true);
+    SetBits(masks, Layer_Enemy, Layer_Enemy, true);
+    SetBits(masks, Layer_Enemy, Layer_Sensor, true);
+    return true;
+}
+
+// Mascaras de cada capa. Estatica local para que este lista antes de que
+// cualquier fabrica la use; el inicializador de una estatica local corre
+// una sola vez aunque varios hilos armen escenas a la vez (BatchSimulator)
+uint16* CollisionLayers::Masks()
+{
+    static uint16 masks[Layer_Count];
+    static const bool initialized = FillDefaults(masks);
+    (void)initialized;
+    return masks;
+}
+
+// Vuelve a la tabla por defecto. A diferencia de la primera carga no es
+// seguro llamarla mientras otros hilos crean fixtures
+void CollisionLayers::ResetDefaults()
+{
+    FillDefaults(Masks());
+}
+
+// Todas las capas chocan con todas (el comportamiento sin filtros)
+void CollisionLayers::SetAllCollide()
+{
+    uint16* masks = Masks();
+    for (int i = 0; i < Layer_Count; ++i)
+        masks[i] = 0xFFFF;
+}
+
+bool CollisionLayers::Collides(CollisionLayer a, CollisionLayer b)
+{
+    return (Mask(a) & Category(b)) != 0 && (Mask(b) & Category(a)) != 0;
+}
+
+void CollisionLayers::SetCollides(CollisionLayer a, CollisionLayer b, bool collide)
+{
+    SetBits(Masks(), a, b, collide);
+}
+
+b2Filter CollisionLayers::MakeFilter(CollisionLayer layer)
+{
+    b2Filter filter;
+    filter.categoryBits = Category(layer);
+    filter.maskBits = Mask(layer);
+    filter.groupIndex = 0;
+    return filter;
+}
+
+CollisionLayer CollisionLayers::DefaultLayer(b2BodyType type)
+{
+    switch (type)
+    {
+    case b2_staticBody: return Layer_StaticWorld;
+    case b2_kinematicBody: return Layer_Player;
+    default: return Layer_Enemy;
+    }
+}
+
+CollisionLayer CollisionLayers::LayerFromCategory(uint16 categoryBits)
+{
+    for (int i = 0; i < Layer_Count; ++i)
+    {
+        if (categoryBits & Category((CollisionLayer)i))
+            return (CollisionLayer)i;
+    }
+    return Layer_Enemy;
+}
+
+void CollisionLayers::Apply(b2Body* body, CollisionLayer layer)
+{
+    b2Filter filter = MakeFilter(layer);
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        fixture->SetFilterData(filter);
+}
+
+void CollisionLayers::Refilter(b2World* phyWorld)
+{
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            b2Filter filter = fixture->GetFilterData();
+            uint16 mask = Mask(LayerFromCategory(filter.categoryBits));
+            if (filter.maskBits != mask)
+            {
+                filter.maskBits = mask;
+                fixture->SetFilterData(filter); // Marca los contactos para volver a filtrarlos
+            }
+        }
+    }
+}
+
+const char* CollisionLayers::GetName(CollisionLayer layer)
+{
+    static const char* names[Layer_Count] = { "mundo", "jugador", "proyectil", "enemigo", "sensor" };
+    return (layer >= 0 && layer < Layer_Count) ? names[layer] : "?";
+}
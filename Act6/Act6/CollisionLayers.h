@@ -0,0 +1,59 @@
+//-----------------------------------------------------
+//Capas de colision con nombre. Cada capa es un bit de
+//categoria de b2Filter y la matriz de la clase dice
+//que capas chocan entre si. Box2D descarta los pares
+//filtrados antes del narrowphase, sin crear contactos
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+
+enum CollisionLayer
+{
+	Layer_StaticWorld = 0,	// Suelo, paredes, obstaculos
+	Layer_Player,			// Cuerpo de control (caon, pelota, bloque), ver DefaultLayer
+	Layer_Projectile,		// Balas
+	Layer_Enemy,			// Enemigos y cuerpos dinamicos sueltos
+	Layer_Sensor,			// Zonas de deteccion
+	Layer_Count
+};
+
+class CollisionLayers
+{
+private:
+	static uint16* Masks();
+
+public:
+	// Bit de categoria de la capa
+	static uint16 Category(CollisionLayer layer) { return (uint16)(1u << layer); }
+
+	// Mascara actual de la capa (con que capas choca)
+	static uint16 Mask(CollisionLayer layer) { return Masks()[layer]; }
+
+	// Filtro listo para asignar a b2FixtureDef::filter
+	static b2Filter MakeFilter(CollisionLayer layer);
+
+	// Capa por defecto segun el tipo de cuerpo, la usan las fabricas de Box2DHelper:
+	// estaticos al mundo, cinematicos al jugador y dinamicos a enemigo. El tipo
+	// no alcanza para reconocer la pelota o el bloque de control: quien arma la
+	// escena los pasa a Layer_Player con Apply
+	static CollisionLayer DefaultLayer(b2BodyType type);
+
+	// Capa a partir de los bits de categoria de una fixture
+	static CollisionLayer LayerFromCategory(uint16 categoryBits);
+
+	// Tabla de colisiones en tiempo de ejecucion (siempre simetrica)
+	static bool Collides(CollisionLayer a, CollisionLayer b);
+	static void SetCollides(CollisionLayer a, CollisionLayer b, bool collide);
+	static void SetAllCollide();
+	static void ResetDefaults();
+
+	// Asigna la capa a todas las fixtures del cuerpo
+	static void Apply(b2Body* body, CollisionLayer layer);
+
+	// Vuelve a aplicar las mascaras a todas las fixtures del mundo despues de
+	// cambiar la tabla. Es O(fixtures), solo se llama cuando la tabla cambia
+	static void Refilter(b2World* phyWorld);
+
+	static const char* GetName(CollisionLayer layer);
+};
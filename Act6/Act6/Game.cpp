@@ -1,9 +1,16 @@
 #include "Game.h"
 #include "Box2DHelper.h"
+#include "CollisionLayers.h"
+#include "SceneFile.h"
+#include "Scenes.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 
 // Constructor de la clase Game
-Game::Game(int ancho, int alto, std::string titulo)
+Game::Game(int ancho, int alto, std::string titulo, std::string escena, StressParams estres)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
@@ -11,8 +18,21 @@ Game::Game(int ancho, int alto, std::string titulo)
     fps = 60;
     wnd->setFramerateLimit(fps);
     frameTime = 1.0f / fps;
+    paused = false;
+    rewindFrame = 0;
+    showHud = false;
+    frameMs = 0.0f;
+    simTime = 0.0f;
+    frameCount = 0;
+    title = titulo;
+    scenePath = escena;
+    stressParams = estres;
+    lastMousePixel = Vector2i(-1, -1);
+    frameAllocations = FrameAllocations();
+    InitShapes(alto); // Formas fijas de DrawGame
     SetZoom(); // Configuracin de la vista del juego
     InitPhysics(); // Inicializacin del motor de fsica
+    RunAudit(); // Reporte inicial de la escena
 }
 
 // Bucle principal del juego
@@ -20,51 +40,134 @@ void Game::Loop()
 {
     while (wnd->isOpen())
     {
+        frameClock.restart();
+        AllocationTracker::BeginFrame();
         wnd->clear(clearColor); // Limpiar la ventana
         DoEvents(); // Procesar eventos de entrada
-        CheckCollitions(); // Comprobar colisiones
+        CheckSceneFile(); // Recargar la escena si se edit el archivo
         CannonRotation(); //Actualizo el caon 
-        UpdatePhysics(); // Actualizar la simulacin fsica
+        UpdatePhysics(); // Actualizar la simulacin fsica y procesar sus contactos
         DrawGame(); // Dibujar el juego
+        DrawHud(); // Grfico de los contadores de fsica
+        frameMs = frameClock.getElapsedTime().asMicroseconds() / 1000.0f;
         wnd->display(); // Mostrar la ventana
+        UpdateTitle(); // Contadores de balas en el ttulo
+        CheckAllocations(); // Memoria asignada en el frame
     }
 }
 
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
-    phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
+    if (!paused)
+    {
+        impacts.BeginStep(); // Olvidar los impulsos del paso anterior
+        {
+            HotSection hot("Step");
+            phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+        }
+        phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
+        simTime += frameTime;
+        CheckCollitions(); // Procesar los contactos del paso mientras sus fixtures siguen vivas
+        projectiles->Update(simTime); // Destruir en lote las balas vencidas, fuera del Step
+        SpawnTracers(); // Estela de las balas que siguen vivas
+    }
+
+    // Lo que solo lee el mundo corre en las tareas mientras este hilo dibuja
+    // la depuracin; nadie toca el mundo hasta que terminan
+    Job* frameJobs = StartFrameJobs();
     phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    jobs->Wait(frameJobs);
 }
 
-// Dibujo de los elementos del juego
-void Game::DrawGame()
+// Encola el trabajo del frame posterior al Step: auditora, historial,
+// contadores y lneas de visin no dependen entre s; el armado de las lneas a dibujar
+// espera a las de visin. Devuelve la tarea que agrupa a todas
+Job* Game::StartFrameJobs()
+{
+    Job* frame = jobs->Create(nullptr);
+    if (!paused)
+    {
+        jobs->Run(jobs->Create([this] { audit.Observe(phyWorld, frameTime); }, frame)); // Seguir los cuerpos para la auditora
+        jobs->Run(jobs->Create([this] { rewind.Record(phyWorld); }, frame)); // Guardar el paso en el historial
+        b2Vec2 gravity = phyWorld->GetGravity();
+        jobs->Run(jobs->Create([this, gravity] { particles->Update(frameTime, gravity); }, frame)); // Mover las partculas
+        int bullets = projectiles->GetLiveCount();
+        jobs->Run(jobs->Create([this, bullets] { counters.Sample(phyWorld, bullets, frameMs); }, frame)); // Contadores del paso
+    }
+    Job* sight = jobs->Create([this] { UpdateSightLines(); }, frame);
+    Job* lines = jobs->Create([this] { BuildSightLines(); }, frame);
+    jobs->AddDependency(lines, sight);
+    jobs->Run(lines);
+    jobs->Run(sight);
+    jobs->Run(frame);
+    return frame;
+}
+
+// Arma las formas que dibuja DrawGame. Cada sf::Shape guarda sus vrtices
+// en memoria propia: crearlas en cada frame asignaba en todos los frames
+void Game::InitShapes(int alto)
 {
-    // Dibujar el suelo
-    sf::RectangleShape groundShape(sf::Vector2f(500, 5));
+    // El suelo
+    groundShape.setSize(sf::Vector2f(500, 5));
     groundShape.setFillColor(sf::Color::Red);
     groundShape.setPosition(0, 95);
-    wnd->draw(groundShape);
 
-    // Dibujar las paredes
-    sf::RectangleShape leftWallShape(sf::Vector2f(10, alto)); // Alto de la ventana
+    // Las paredes
+    leftWallShape.setSize(sf::Vector2f(10, (float)alto)); // Alto de la ventana
     leftWallShape.setFillColor(sf::Color::Red);
     leftWallShape.setPosition(100, 0); // X = 100 para que comience donde termina el suelo
-    wnd->draw(leftWallShape);
 
-    sf::RectangleShape rightWallShape(sf::Vector2f(10, alto)); // Alto de la ventana
+    rightWallShape.setSize(sf::Vector2f(10, (float)alto)); // Alto de la ventana
     rightWallShape.setFillColor(sf::Color::Red);
     rightWallShape.setPosition(90, 0); // X = 90 para que comience donde termina el suelo
+
+    // El caon (cuerpo de control); la posicin y el ngulo se copian al dibujar
+    cannonShape.setSize(sf::Vector2f(15.0f, 10.0f));
+    cannonShape.setFillColor(sf::Color::Red);
+    cannonShape.setOrigin(7.5f, 5.0f); // Origen en la base del can
+}
+
+// Dibujo de los elementos del juego
+void Game::DrawGame()
+{
+    HotSection hot("DrawGame");
+    AllocationScope scope(Alloc_Drawing);
+
+    // Dibujar el suelo y las paredes
+    wnd->draw(groundShape);
+    wnd->draw(leftWallShape);
     wnd->draw(rightWallShape);
 
     // Dibujar el caon (cuerpo de control)
-    sf::RectangleShape cannonShape(sf::Vector2f(15.0f, 10.0f));
-    cannonShape.setFillColor(sf::Color::Red);
     cannonShape.setPosition(controlBody->GetPosition().x, controlBody->GetPosition().y);
-    cannonShape.setOrigin(7.5f, 5.0f); // Origen en la base del can
     cannonShape.setRotation(controlBody->GetAngle() * 180 / b2_pi); // Box2D usa radianes, SFML grados
     wnd->draw(cannonShape);
+
+    // Lneas de visin de los enemigos que ven el can y la mira
+    wnd->draw(sightLines);
+
+    // Todas las partculas en una sola llamada
+    wnd->draw(particles->GetVertices());
+}
+
+// Arma las lneas de visin de los enemigos que ven el can y la mira.
+// Corre en una tarea despus de UpdateSightLines
+void Game::BuildSightLines()
+{
+    sightLines.clear();
+    sightLines.setPrimitiveType(Lines);
+    b2Vec2 cannonPos = controlBody->GetPosition();
+    for (size_t i = 0; i < enemies.size(); ++i)
+    {
+        if (!enemyCanSee[i])
+            continue;
+        b2Vec2 enemyPos = enemies[i]->GetPosition();
+        sightLines.append(Vertex(Vector2f(enemyPos.x, enemyPos.y), Color::Yellow));
+        sightLines.append(Vertex(Vector2f(cannonPos.x, cannonPos.y), Color::Yellow));
+    }
+    sightLines.append(Vertex(Vector2f(cannonPos.x, cannonPos.y), Color::Green));
+    sightLines.append(Vertex(Vector2f(aimPoint.x, aimPoint.y), Color::Green));
 }
 
 // Procesamiento de eventos de entrada
@@ -78,19 +181,104 @@ void Game::DoEvents()
         case Event::Closed:
             wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
             break;
+        case Event::MouseButtonPressed:
+            // Agarrar el cuerpo bajo el cursor
+            if (evt.mouseButton.button == Mouse::Left) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseButton.x, evt.mouseButton.y));
+                picker.Grab(b2Vec2(pos.x, pos.y));
+            }
+            // Bala explosiva
+            if (evt.mouseButton.button == Mouse::Right)
+                Shoot(Projectile_Explosive);
+            break;
+        case Event::MouseMoved:
+            if (picker.IsDragging()) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseMove.x, evt.mouseMove.y));
+                picker.Drag(b2Vec2(pos.x, pos.y));
+            }
+            break;
+        case Event::MouseButtonReleased:
+            if (evt.mouseButton.button == Mouse::Left)
+                picker.Release();
+            break;
         case Event::KeyPressed:
 
             if (Keyboard::isKeyPressed(Keyboard::Space)) {
-                Shoot();
+                Shoot(Projectile_Normal);
+            }
+            if (evt.key.code == Keyboard::F1) {
+                RunAudit();
+            }
+            if (evt.key.code == Keyboard::F2) {
+                showHud = !showHud;
+            }
+            if (evt.key.code == Keyboard::F3) {
+                ExportCounters();
+            }
+            if (evt.key.code == Keyboard::F4) {
+                PrintAllocations();
+            }
+            if (evt.key.code == Keyboard::R) {
+                ResetScene();
+            }
+            // Pausa y recorrido del historial (con Shift de a 10 frames)
+            if (evt.key.code == Keyboard::P) {
+                TogglePause();
+            }
+            if (evt.key.code == Keyboard::Left) {
+                Scrub(evt.key.shift ? -10 : -1);
+            }
+            if (evt.key.code == Keyboard::Right) {
+                Scrub(evt.key.shift ? 10 : 1);
+            }
+            if (evt.key.code == Keyboard::E) {
+                // Nuevo enemigo donde est el mouse
+                Vector2f mouseWorld = wnd->mapPixelToCoords(Mouse::getPosition(*wnd));
+                CreateEnemy((int)mouseWorld.x, (int)mouseWorld.y);
+            }
+            if (evt.key.code == Keyboard::B) {
+                // Activar o desactivar el choque entre balas en tiempo de ejecucin
+                bool collide = !CollisionLayers::Collides(Layer_Projectile, Layer_Projectile);
+                CollisionLayers::SetCollides(Layer_Projectile, Layer_Projectile, collide);
+                CollisionLayers::Refilter(phyWorld);
+                std::cout << "Choque entre balas: " << (collide ? "si" : "no") << "\n";
             }
         }
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en un solo lote los eventos que el
+// listener guard durante el Step (el mundo ya no est bloqueado). Corre
+// antes de ProjectileManager::Update, as las fixtures de las balas que
+// tocaron algo todava existen cuando se leen su tipo y su cuerpo
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    contactEvents.Drain([this](const ContactEvent& evt) {
+        switch (evt.type)
+        {
+        case ContactEvent_Begin:
+            contactCount++;
+            if (ProjectileManager::GetKind(evt.fixtureA) == Projectile_Explosive)
+                Explode(evt.fixtureA, evt.point);
+            else if (ProjectileManager::GetKind(evt.fixtureB) == Projectile_Explosive)
+                Explode(evt.fixtureB, evt.point);
+            break;
+        case ContactEvent_End:
+            contactCount--;
+            break;
+        case ContactEvent_Impact:
+            impactCount++;
+            // Chispas en todas direcciones, ms cuanto ms fuerte el golpe
+            particles->SpawnBurst(evt.point, 0.0f, 2.0f * b2_pi, 5.0f, 15.0f, b2Min(8 + (int)evt.impulse / 10, 40), 0.4f, Color(255, 220, 120));
+            break;
+        }
+    });
+
+    // Los golpes ms fuertes del paso, ya sumados por cuerpo: sirven para
+    // dao o sonido sin volver a recorrer los contactos
+    impacts.GetTopImpacts(4, topImpacts, 20.0f);
+    for (const BodyImpact& impact : topImpacts)
+        strongestImpact = b2Max(strongestImpact, impact.maxImpulse);
 }
 
 // Configuracin de la vista del juego
@@ -104,8 +292,16 @@ void Game::SetZoom()
 }
 
 void Game::CannonRotation() {
-    // Obtener posicin del mouse en coordenadas del mundo
+    // Obtener posicin del mouse en pixeles
     Vector2i mousePixel = Mouse::getPosition(*wnd);
+
+    // Si el mouse no se movi y el can ya lleg al ngulo pedido no hay
+    // nada que hacer: el cuerpo queda quieto y el broadphase no se entera
+    if (mousePixel == lastMousePixel && controlBody->GetAngularVelocity() == 0.0f)
+        return;
+    lastMousePixel = mousePixel;
+
+    // Posicin del mouse en coordenadas del mundo
     Vector2f mouseWorld = wnd->mapPixelToCoords(mousePixel);
 
     // Obtener posicin del can en pixeles
@@ -117,11 +313,24 @@ void Game::CannonRotation() {
     float dy = mouseWorld.y - cannonPosPixels.y;
     float angle = std::atan2(dy, dx); //Radianes
 
-    // Aplicar rotacin
-    controlBody->SetTransform(controlBody->GetPosition(), angle);
+    // Diferencia con el ngulo actual, por el camino ms corto
+    float delta = angle - controlBody->GetAngle();
+    delta = std::remainder(delta, 2.0f * b2_pi);
+
+    // Aplicar rotacin: en vez de teletransportar el cuerpo con SetTransform
+    // le damos la velocidad angular que lo lleva al objetivo. As los
+    // contactos con las balas se resuelven con la velocidad real. Box2D no
+    // gira ms de b2_maxRotation (90) por paso, tampoco a los cinemticos:
+    // hasta 90 llega en un paso y los giros mayores tardan dos
+    if (std::fabs(delta) < 1.0e-4f)
+        controlBody->SetAngularVelocity(0.0f);
+    else
+        controlBody->SetAngularVelocity(b2Clamp(delta, -b2_maxRotation, b2_maxRotation) / frameTime);
 }
 
-void Game::Shoot() {
+void Game::Shoot(ProjectileKind kind) {
+    AllocationScope scope(Alloc_Projectiles);
+
     // Obtener el ngulo actual del can
     float angle = controlBody->GetAngle();   // ngulo en radianes
     b2Vec2 cannonPos = controlBody->GetPosition();
@@ -135,14 +344,29 @@ void Game::Shoot() {
     b2Vec2 tipPos(cannonPos.x + dx,
         cannonPos.y + dy);
 
-    // crear bala
-    b2Body* bullet = Box2DHelper::CreateCircularDynamicBody(phyWorld, 0.5f, 1.0f, 0.2f, 0.1f);
-    bullet->SetTransform(tipPos, angle);
-
-    // velocidad inicial
+    // crear bala (el administrador la sigue y la destruye cuando corresponde)
     float speed = 50.0f;
-    bullet->SetLinearVelocity(b2Vec2(std::cos(angle) * speed,
-        std::sin(angle) * speed));
+    projectiles->Spawn(tipPos, angle, speed, simTime, kind);
+
+    // Fogonazo en la punta y la vaina que sale despedida hacia arriba del can
+    particles->SpawnBurst(tipPos, angle, 0.6f, 10.0f, 30.0f, 16, 0.25f, Color(255, 200, 80));
+    particles->SpawnBurst(cannonPos, angle - 0.5f * b2_pi, 0.5f, 4.0f, 8.0f, 1, 1.5f, Color(200, 170, 60));
+}
+
+// Un punto de estela por bala viva: queda casi quieto y se apaga enseguida
+void Game::SpawnTracers()
+{
+    projectiles->GetBodies(bulletBodies);
+    for (b2Body* bullet : bulletBodies)
+        particles->Spawn(bullet->GetPosition(), 0.05f * bullet->GetLinearVelocity(), 0.2f, Color::White);
+}
+
+// Una bala explosiva toc algo: empuja a los cuerpos cercanos y se descarta
+void Game::Explode(b2Fixture* bullet, const b2Vec2& point)
+{
+    ProjectileManager::Defuse(bullet); // Puede llegar ms de un contacto en el mismo paso
+    explosion->ApplyRadialImpulse(point, 15.0f, 500.0f, Falloff_Linear);
+    projectiles->Despawn(bullet->GetBody());
 }
 
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
@@ -156,28 +380,415 @@ void Game::InitPhysics()
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
-    // Crear el suelo y las paredes estticas del mundo fsico
-    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
-    b2Fixture* groundFixture = groundBody->GetFixtureList();
-    groundFixture->SetFriction(0.5f);
+    // Registrar la cola de eventos de contacto
+    contactCount = 0;
+    impactCount = 0;
+    phyWorld->SetContactListener(&contactEvents);
+    phyWorld->SetDestructionListener(&contactEvents); // Olvida las fixtures destruidas con eventos pendientes
+
+    // Cuerpo ancla para arrastrar con el mouse
+    picker.Init(phyWorld);
+
+    // Estadsticas de impacto por cuerpo, encadenadas detrs de la cola
+    strongestImpact = 0.0f;
+    contactEvents.SetNext(&impacts);
+    contactEvents.SetNextDestruction(&impacts);
+
+    // Crear el suelo, las paredes y el can: desde el archivo de escena si
+    // se pas uno, si no el mismo armado que usan las herramientas
+    // Las balas se descartan al salir de esta caja (se deja margen arriba
+    // para los tiros parablicos), a los 10 segundos o cuando quedan quietas
+    b2AABB bounds;
+    bounds.lowerBound.Set(-20.0f, -200.0f);
+    bounds.upperBound.Set(120.0f, 120.0f);
+
+    controlBody = nullptr;
+    if (stressParams.bodyCount > 0)
+        controlBody = BuildStressScene(bounds);
+    else if (!scenePath.empty())
+        controlBody = LoadScene(scenePath);
+    if (!controlBody)
+        controlBody = Scenes::BuildAct6(phyWorld);
+    projectiles = new ProjectileManager(phyWorld, bounds, 10.0f);
+    particles = new ParticleSystem(200000);
+
+    // Sistema de tareas del frame y algunos enemigos en el suelo
+    jobs = new JobSystem();
+    sightQuery = new ParallelQuery(phyWorld, jobs);
+    explosion = new Explosion(phyWorld);
+    aimPoint = controlBody->GetPosition();
+    CreateEnemy(45, 90);
+    CreateEnemy(65, 90);
+    CreateEnemy(85, 90);
+
+    // Foto del estado inicial para reiniciar con la R
+    initialState.Capture(phyWorld);
+}
+
+// Vuelve la escena al estado del inicio sin reconstruir el mundo: las
+// balas y los enemigos creados despus se destruyen y el resto de los
+// cuerpos recupera la posicin y velocidad de la foto
+void Game::ResetScene()
+{
+    auto start = std::chrono::steady_clock::now();
+    picker.Release(); // El joint del mouse no es parte de la foto
+    projectiles->Clear();
+    particles->Clear();
+
+    std::vector<b2Body*> created;
+    if (!initialState.Restore(phyWorld, &created))
+    {
+        std::cout << "Reinicio: falta algun cuerpo de la foto\n";
+        return;
+    }
+    for (b2Body* body : created)
+    {
+        auto enemy = std::find(enemies.begin(), enemies.end(), body);
+        if (enemy != enemies.end())
+        {
+            enemyCanSee.erase(enemyCanSee.begin() + (enemy - enemies.begin()));
+            enemies.erase(enemy);
+        }
+        phyWorld->DestroyBody(body);
+    }
+    rewind.Clear(); // Se destruyeron cuerpos sin un Record despues: el historial ya no vale
+    audit.Reset(); // Restore usa SetTransform (el can girado): no es un teletransporte del juego
+    lastMousePixel = Vector2i(-1, -1); // Que el can vuelva a apuntar al mouse
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("Reinicio: %d cuerpos, %d destruidos, %.3f ms\n", initialState.GetBodyCount(), (int)created.size(), elapsed.count());
+}
+
+// Pausa la simulacin o la retoma desde el frame que se est mostrando;
+// los frames posteriores se descartan porque desde ah la historia cambia
+void Game::TogglePause()
+{
+    if (!paused)
+    {
+        paused = true;
+        rewindFrame = rewind.GetFrameCount() - 1;
+        std::printf("Pausa: %d frames, %d KB\n", rewind.GetFrameCount(), (int)(rewind.GetUsedBytes() / 1024));
+    }
+    else
+    {
+        // Si se retrocedi, Restore movi los cuerpos con SetTransform y la
+        // auditora los comparara contra la posicin de antes de la pausa
+        if (rewindFrame < rewind.GetFrameCount() - 1)
+            audit.Reset();
+        rewind.DiscardAfter(rewindFrame);
+        paused = false;
+    }
+}
+
+// En pausa, mueve el frame mostrado y lo escribe en el mundo
+void Game::Scrub(int frames)
+{
+    if (!paused || rewind.GetFrameCount() == 0)
+        return;
+    rewindFrame = b2Clamp(rewindFrame + frames, 0, rewind.GetFrameCount() - 1);
+    rewind.Restore(phyWorld, rewindFrame);
+    std::printf("Frame %d/%d (%.2f s)\n", rewindFrame + 1, rewind.GetFrameCount(), (rewindFrame + 1 - rewind.GetFrameCount()) * frameTime);
+}
+
+// Carga la escena del archivo (texto o binario) y mide cunto tarda. Si
+// falla o no tiene cuerpo de control devuelve nullptr sin tocar el mundo
+b2Body* Game::LoadScene(const std::string& path)
+{
+    if (SceneFile::IsBinary(path))
+        return LoadMappedScene(path);
+
+    auto start = std::chrono::steady_clock::now();
+    SceneData data;
+    std::string error;
+    if (!SceneFile::Load(path, data, error))
+    {
+        std::cout << "Escena: " << error << "\n";
+        return nullptr;
+    }
+    if (data.controlBody < 0)
+    {
+        std::cout << "Escena: " << path << " no marca un cuerpo de control\n";
+        return nullptr;
+    }
+    auto loaded = std::chrono::steady_clock::now();
+
+    std::vector<b2Body*> created;
+    b2Body* body = SceneFile::Build(data, phyWorld, &created);
+    auto built = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::milli> readMs = loaded - start;
+    std::chrono::duration<double, std::milli> buildMs = built - loaded;
+    std::printf("Escena %s: %d cuerpos, %d fixtures, lectura %.2f ms, armado %.2f ms\n",
+        path.c_str(), (int)data.bodies.size(), (int)data.fixtures.size(), readMs.count(), buildMs.count());
+
+    // La escena de texto se vigila para recargarla al guardarla. La binaria
+    // no: es la salida de "compilar" y se mapea sin copiarla
+    sceneReloader.Watch(path, data, created);
+    return body;
+}
+
+// Escena binaria: se mapea el archivo y Build() lee los cuerpos en el
+// lugar, sin copiarlos a un SceneData. El mapeo se suelta al terminar
+// porque Box2D ya copi todo lo que necesita
+b2Body* Game::LoadMappedScene(const std::string& path)
+{
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    SceneView view;
+    std::string error;
+    if (!SceneFile::MapBinary(path, file, view, error))
+    {
+        std::cout << "Escena: " << error << "\n";
+        return nullptr;
+    }
+    if (view.header->controlBody < 0 || view.header->controlBody >= view.bodyCount)
+    {
+        std::cout << "Escena: " << path << " no marca un cuerpo de control\n";
+        return nullptr;
+    }
+    auto mapped = std::chrono::steady_clock::now();
+
+    b2Body* body = SceneFile::Build(view, phyWorld);
+    auto built = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double, std::milli> mapMs = mapped - start;
+    std::chrono::duration<double, std::milli> buildMs = built - mapped;
+    std::printf("Escena %s (mapeada): %d cuerpos, %d fixtures, mapeo %.2f ms, armado %.2f ms\n",
+        path.c_str(), view.bodyCount, view.fixtureCount, mapMs.count(), buildMs.count());
+    return body;
+}
+
+// Escena de estrs generada: mide el armado, agranda la caja de las balas
+// para que la contenga y aleja la cmara hasta verla entera
+b2Body* Game::BuildStressScene(b2AABB& bounds)
+{
+    auto start = std::chrono::steady_clock::now();
+    StressSceneInfo info = StressScenes::Build(phyWorld, stressParams);
+    std::chrono::duration<double, std::milli> buildMs = std::chrono::steady_clock::now() - start;
+    std::printf("Estres %s (semilla %u): %d dinamicos, %d fijos, armado %.2f ms\n", StressScenes::GetName(stressParams.kind),
+        stressParams.seed, info.dynamicCount, info.staticCount, buildMs.count());
+
+    bounds.lowerBound = b2Min(bounds.lowerBound, info.bounds.lowerBound - b2Vec2(20.0f, 200.0f));
+    bounds.upperBound = b2Max(bounds.upperBound, info.bounds.upperBound + b2Vec2(20.0f, 20.0f));
+
+    b2Vec2 size = info.bounds.upperBound - info.bounds.lowerBound;
+    b2Vec2 center = 0.5f * (info.bounds.lowerBound + info.bounds.upperBound);
+    float side = b2Max(size.x, size.y) * 1.1f;
+    View camara;
+    camara.setSize(side, side);
+    camara.setCenter(center.x, center.y);
+    wnd->setView(camara);
+    return info.controlBody;
+}
+
+// Si el archivo de escena cambi aplica solo las diferencias: el mundo, la
+// ventana, las balas y los enemigos siguen como estaban
+void Game::CheckSceneFile()
+{
+    if (!sceneReloader.Poll(frameTime))
+        return;
+
+    picker.Release(); // El cuerpo agarrado puede ser uno de los que se rehacen
+    SceneReloadStats stats;
+    std::string error;
+    if (!sceneReloader.Reload(phyWorld, stats, error))
+    {
+        std::cout << "Recarga: " << error << " (se mantiene la escena anterior)\n";
+        return;
+    }
+    controlBody = sceneReloader.GetControlBody();
+    lastMousePixel = Vector2i(-1, -1);
+
+    // Si se crearon o destruyeron cuerpos la foto de la R y el historial
+    // apuntan a otros cuerpos: se empiezan de nuevo desde ac
+    if (stats.created + stats.destroyed + stats.rebuilt > 0)
+    {
+        projectiles->Clear();
+        initialState.Capture(phyWorld);
+        rewind.Clear();
+    }
+    audit.Reset(); // Patch mueve los cinemticos con SetTransform: no son teletransportes del juego
+
+    std::printf("Recarga %s: %d nuevos, %d borrados, %d rehechos, %d modificados, %d iguales; lectura %.2f ms, cambios %.2f ms\n",
+        sceneReloader.GetPath().c_str(), stats.created, stats.destroyed, stats.rebuilt, stats.patched, stats.unchanged, stats.readMs, stats.applyMs);
+}
+
+// Crea un enemigo (caja dinmica de 4 x 4 m) en la posicin dada, en metros
+void Game::CreateEnemy(int x, int y)
+{
+    b2Body* enemy = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 4, 4, 1.0f, 0.5f, 0.1f);
+    enemy->SetTransform(b2Vec2((float)x, (float)y), 0.0f);
+    enemies.push_back(enemy);
+    enemyCanSee.push_back(false);
+}
+
+// Un rayo por enemigo hacia el can (solo lo tapan los estticos) y uno
+// ms para la mira. Corre en una tarea despus del Step; el lote de rayos
+// se reparte a su vez en otras tareas y se espera ah mismo. Mientras
+// tanto nadie modifica el mundo
+void Game::UpdateSightLines()
+{
+    b2Vec2 cannonPos = controlBody->GetPosition();
+    int count = (int)enemies.size();
+    rayFrom.resize(count);
+    rayTo.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        rayFrom[i] = enemies[i]->GetPosition();
+        rayTo[i] = cannonPos;
+    }
+
+    sightQuery->RayCastClosest(rayFrom.data(), rayTo.data(), count, CollisionLayers::Category(Layer_StaticWorld));
+    for (int i = 0; i < count; ++i)
+        enemyCanSee[i] = sightQuery->GetHit(i).fixture == nullptr;
+
+    // La mira va aparte: es un solo rayo y choca tambin con enemigos
+    float angle = controlBody->GetAngle();
+    b2Vec2 dir(std::cos(angle), std::sin(angle));
+    b2Vec2 from = cannonPos + 7.5f * dir;
+    b2Vec2 to = cannonPos + 200.0f * dir;
+    uint16 aimMask = CollisionLayers::Category(Layer_StaticWorld) | CollisionLayers::Category(Layer_Enemy);
+    sightQuery->RayCastClosest(&from, &to, 1, aimMask);
+    const RayHit& aim = sightQuery->GetHit(0);
+    aimPoint = aim.fixture ? aim.point : to;
+}
+
+// Auditora de la escena: imprime en consola las configuraciones costosas
+void Game::RunAudit()
+{
+    std::vector<AuditFinding> findings = audit.Run(phyWorld);
+    std::cout << "--- Auditoria de escena ---\n";
+    SceneAudit::Print(findings, std::cout);
+}
+
+// Muestra los contadores de balas y golpes en el ttulo, una vez por segundo.
+// Con el HUD prendido muestra los de fsica del ltimo frame
+void Game::UpdateTitle()
+{
+    if (++frameCount % fps != 0)
+        return;
+
+    char buffer[192];
+    FrameCounters latest;
+    if (showHud && counters.GetLatest(latest))
+    {
+        std::snprintf(buffer, sizeof(buffer), " - cuerpos: %d (despiertos %d, dormidos %.0f%%), islas: %d, contactos: %d, balas: %d, arbol: %d/%d/%.2f, paso %.2f ms, frame %.2f ms",
+            latest.bodyCount, latest.awakeBodies, 100.0f * latest.sleepingRatio, latest.islands, latest.contactCount, latest.bullets,
+            latest.treeHeight, latest.treeBalance, latest.treeQuality, latest.profile.step, latest.frameMs);
+    }
+    else
+    {
+        std::snprintf(buffer, sizeof(buffer), " - balas vivas: %d, descartadas: %d, golpes: %d (max %.0f N*s)", projectiles->GetLiveCount(), projectiles->GetDespawnedCount(), impactCount, strongestImpact);
+    }
+    wnd->setTitle(title + buffer);
+    strongestImpact = 0.0f;
+}
+
+// Grfico de los ltimos frames abajo a la izquierda, en pixeles: una barra
+// por frame con colisin (naranja), resolucin (azul), broadphase (verde)
+// y TOI (violeta) apiladas, y una lnea en 16.7 ms (60 fps)
+void Game::DrawHud()
+{
+    if (!showHud)
+        return;
+    AllocationScope scope(Alloc_Drawing);
+
+    const int columns = 240;
+    const float columnWidth = 2.0f;
+    const float pixelsPerMs = 6.0f;
+    const float budgetMs = 1000.0f / 60.0f;
+
+    hudFrames.resize(columns);
+    int count = counters.CopyRecent(hudFrames.data(), columns);
+
+    Vector2u size = wnd->getSize();
+    float left = 10.0f;
+    float bottom = size.y - 10.0f;
+    float height = 2.0f * budgetMs * pixelsPerMs;
+    float width = columns * columnWidth;
+
+    hudGraph.clear();
+    hudGraph.setPrimitiveType(Quads);
+    auto quad = [this](float x0, float y0, float x1, float y1, Color color) {
+        hudGraph.append(Vertex(Vector2f(x0, y0), color));
+        hudGraph.append(Vertex(Vector2f(x1, y0), color));
+        hudGraph.append(Vertex(Vector2f(x1, y1), color));
+        hudGraph.append(Vertex(Vector2f(x0, y1), color));
+    };
+    quad(left, bottom - height, left + width, bottom, Color(0, 0, 0, 160));
+
+    // Broadphase se mide dentro de la resolucin: se resta para no contarlo dos veces
+    for (int i = 0; i < count; ++i)
+    {
+        const b2Profile& p = hudFrames[i].profile;
+        float parts[4] = { p.collide, b2Max(p.solve - p.broadphase, 0.0f), p.broadphase, p.solveTOI };
+        const Color colors[4] = { Color(255, 160, 0), Color(60, 140, 255), Color(80, 220, 80), Color(200, 80, 220) };
+        float x = left + (columns - count + i) * columnWidth;
+        float y = bottom;
+        for (int k = 0; k < 4; ++k)
+        {
+            float top = b2Max(y - parts[k] * pixelsPerMs, bottom - height);
+            quad(x, top, x + columnWidth, y, colors[k]);
+            y = top;
+        }
+    }
+    float budgetY = bottom - budgetMs * pixelsPerMs;
+    quad(left, budgetY, left + width, budgetY + 1.0f, Color::Red);
 
-    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
-    b2Fixture* leftWallFixture = leftWallBody->GetFixtureList();
-    leftWallFixture->SetRestitution(1.0f);
+    View previous = wnd->getView();
+    wnd->setView(wnd->getDefaultView());
+    wnd->draw(hudGraph);
+    wnd->setView(previous);
+}
 
-    b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
-    b2Fixture* rightWallFixture = rightWallBody->GetFixtureList();
-    rightWallFixture->SetRestitution(1.0f);
+// Guarda los frames del buffer de contadores (hasta PhysicsCounters::Capacity)
+void Game::ExportCounters()
+{
+    const char* path = "contadores.csv";
+    if (counters.ExportCsv(path))
+        std::printf("Contadores guardados en %s\n", path);
+    else
+        std::printf("No se pudo escribir %s\n", path);
+}
 
-    // Crear un crculo que se controlar con el teclado
-    controlBody = Box2DHelper::CreateRectangularKinematicBody(phyWorld, 15, 10);
-    controlBody->SetTransform(b2Vec2(10.0f, 50.0f), 0.0f);
+// Cierra el frame del contador de memoria. Lo que se asign dentro de una
+// seccin caliente se avisa en el momento: en un frame normal no debera
+// haber nada
+void Game::CheckAllocations()
+{
+    frameAllocations = AllocationTracker::EndFrame();
+    if (frameAllocations.hotAllocations == 0)
+        return;
+    std::printf("Asignaciones en secciones calientes, frame %d:\n", frameCount);
+    AllocationTracker::Print(frameAllocations);
+}
+
+// Asignaciones del ltimo frame y totales por categora desde el inicio
+void Game::PrintAllocations()
+{
+    std::printf("--- Asignaciones del ultimo frame ---\n");
+    AllocationTracker::Print(frameAllocations);
+    std::printf("--- Totales ---\n");
+    for (int i = 0; i < Alloc_Count; ++i)
+    {
+        AllocCounts totals = AllocationTracker::GetTotals((AllocCategory)i);
+        std::printf("  %-9s %8lld asignaciones %11lld bytes\n", AllocationTracker::GetCategoryName((AllocCategory)i), totals.allocations, totals.bytes);
+    }
+    std::printf("  %8lld liberaciones\n", AllocationTracker::GetFrees());
 }
 
 // Destructor de la clase
 
 Game::~Game(void)
-{ }
\ No newline at end of file
+{
+    // Primero lo que usa el mundo, despus el mundo (que destruye sus
+    // cuerpos y joints) y al final la ventana sobre la que dibuja el renderer
+    delete sightQuery;
+    delete jobs;
+    delete explosion;
+    delete projectiles;
+    delete particles;
+    delete phyWorld;
+    delete debugRender;
+    delete wnd;
+}
\ No newline at end of file
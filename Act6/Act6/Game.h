@@ -2,6 +2,20 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "AllocationTracker.h"
+#include "ContactEventQueue.h"
+#include "Explosion.h"
+#include "MousePicker.h"
+#include "ImpactStats.h"
+#include "ParallelQuery.h"
+#include "ParticleSystem.h"
+#include "PhysicsCounters.h"
+#include "ProjectileManager.h"
+#include "RewindBuffer.h"
+#include "SceneAudit.h"
+#include "SceneReloader.h"
+#include "StressScenes.h"
+#include "WorldSnapshot.h"
 #include <list>
 
 using namespace sf;
@@ -18,21 +32,110 @@ private:
 	b2World* phyWorld;
 	SFMLRenderer* debugRender;
 
+	// Eventos de contacto del ltimo paso, se procesan en CheckCollitions
+	ContactEventQueue contactEvents;
+	int contactCount;	// Pares tocndose ahora
+	int impactCount;	// Golpes fuertes desde el inicio
+
+	// Arrastrar cuerpos con el botn izquierdo
+	MousePicker picker;
+
+	// Impulso acumulado por cuerpo en el ltimo paso
+	ImpactStats impacts;
+	std::vector<BodyImpact> topImpacts;
+	float strongestImpact;	// Mayor golpe del ltimo segundo, para el ttulo
+
 	//tiempo de frame
 	float frameTime;
 	int fps;
 
+	// Tiempo simulado (suma de pasos) y titulo base de la ventana
+	float simTime;
+	int frameCount;
+	std::string title;
+
 	// Cuerpo de box2d
 	b2Body* controlBody;
 
+	// Suelo, paredes y can: se arman una vez, DrawGame no asigna memoria
+	RectangleShape groundShape;
+	RectangleShape leftWallShape;
+	RectangleShape rightWallShape;
+	RectangleShape cannonShape;
+
+	// Archivo de escena (vaco: armado por cdigo) y su recarga en caliente
+	std::string scenePath;
+	SceneReloader sceneReloader;
+
+	// Escena de estrs generada (bodyCount 0: no se usa)
+	StressParams stressParams;
+
+	// Ultima posicion del mouse usada para apuntar el caon
+	Vector2i lastMousePixel;
+
+	// Auditoria de la escena (F1 la imprime en consola)
+	SceneAudit audit;
+
+	// Balas disparadas por el caon
+	ProjectileManager* projectiles;
+	std::vector<b2Body*> bulletBodies;
+
+	// Chispas, vainas y estelas de las balas: partculas sin cuerpo de Box2D
+	ParticleSystem* particles;
+
+	// Enemigos y sus lneas de visin hacia el can
+	std::vector<b2Body*> enemies;
+	std::vector<bool> enemyCanSee;
+
+	// Tareas del frame que solo leen el mundo (auditora, historial, lneas
+	// de visin) repartidas en varios hilos, y las consultas en lote
+	JobSystem* jobs;
+	ParallelQuery* sightQuery;
+	std::vector<b2Vec2> rayFrom;
+	std::vector<b2Vec2> rayTo;
+	VertexArray sightLines;	// Lneas de visin y mira, armadas fuera del hilo principal
+
+	// Mira del can: primer obstculo en la direccin del disparo
+	b2Vec2 aimPoint;
+
+	// Impulso radial de las balas explosivas
+	Explosion* explosion;
+
+	// Estado de los cuerpos al terminar InitPhysics, la R vuelve a l
+	WorldSnapshot initialState;
+
+	// Historial de los ltimos 10 segundos: P pausa, flechas recorren
+	RewindBuffer rewind;
+	bool paused;
+	int rewindFrame;	// Frame mostrado mientras est en pausa
+
+	// Contadores de fsica por frame: F2 muestra el grfico y los nmeros
+	// en el ttulo, F3 los exporta a CSV
+	PhysicsCounters counters;
+	std::vector<FrameCounters> hudFrames;
+	VertexArray hudGraph;
+	bool showHud;
+	Clock frameClock;
+	float frameMs;	// Trabajo del ltimo frame, sin la espera del lmite de fps
+
+	// Asignaciones de memoria del ltimo frame (F4 las imprime)
+	FrameAllocations frameAllocations;
+
 public:
 
 	// Constructores, destructores e inicializadores
-	Game(int ancho, int alto, std::string titulo);
+	Game(int ancho, int alto, std::string titulo, std::string escena = "", StressParams estres = StressParams());
 	void CheckCollitions();
 	void CreateEnemy(int x, int y);
 	~Game(void);
 	void InitPhysics();
+	void ResetScene();
+	void TogglePause();
+	void Scrub(int frames);
+	b2Body* LoadScene(const std::string& path);
+	b2Body* LoadMappedScene(const std::string& path);
+	void CheckSceneFile();
+	b2Body* BuildStressScene(b2AABB& bounds);
 
 	// Main game loop
 	void Loop();
@@ -41,6 +144,18 @@ public:
 	void DoEvents();
 	void SetZoom();
 	void CannonRotation();
-	void Shoot();
+	void Shoot(ProjectileKind kind);
+	void Explode(b2Fixture* bullet, const b2Vec2& point);
+	void SpawnTracers();
+	void RunAudit();
+	void UpdateTitle();
+	void DrawHud();
+	void ExportCounters();
+	void InitShapes(int alto);
+	void CheckAllocations();
+	void PrintAllocations();
+	Job* StartFrameJobs();
+	void UpdateSightLines();
+	void BuildSightLines();
 };
 
@@ -0,0 +1,134 @@
+#include "ImpactStats.h"
+#include <algorithm>
+
+// Constructor de la clase ImpactStats
+ImpactStats::ImpactStats()
+{
+    slots.reserve(256);
+    touched.reserve(256);
+}
+
+int ImpactStats::GetSlot(const b2Body* body)
+{
+    return (int)body->GetUserData().pointer - 1;
+}
+
+// Reusa un slot libre o agrega uno al final
+int ImpactStats::Acquire(b2Body* body)
+{
+    int slot = GetSlot(body);
+    if (slot >= 0)
+        return slot;
+
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = (int)slots.size();
+        slots.push_back(BodyImpact());
+    }
+    slots[slot].body = body;
+    slots[slot].maxImpulse = 0.0f;
+    slots[slot].totalImpulse = 0.0f;
+    slots[slot].contacts = 0;
+    body->GetUserData().pointer = (uintptr_t)(slot + 1);
+    return slot;
+}
+
+void ImpactStats::Release(b2Body* body)
+{
+    int slot = GetSlot(body);
+    if (slot < 0)
+        return;
+
+    // Si el slot estaba tocado en este paso se vacia para que no aparezca
+    // en GetTopImpacts con un cuerpo que ya no existe
+    slots[slot].body = nullptr;
+    slots[slot].maxImpulse = 0.0f;
+    slots[slot].totalImpulse = 0.0f;
+    slots[slot].contacts = 0;
+    freeSlots.push_back(slot);
+    body->GetUserData().pointer = 0;
+}
+
+void ImpactStats::BeginStep()
+{
+    for (int slot : touched)
+    {
+        slots[slot].maxImpulse = 0.0f;
+        slots[slot].totalImpulse = 0.0f;
+        slots[slot].contacts = 0;
+    }
+    touched.clear();
+}
+
+void ImpactStats::Accumulate(b2Body* body, float maxImpulse, float totalImpulse)
+{
+    BodyImpact& impact = slots[Acquire(body)];
+    if (impact.contacts == 0)
+        touched.push_back(GetSlot(body));
+    impact.maxImpulse = b2Max(impact.maxImpulse, maxImpulse);
+    impact.totalImpulse += totalImpulse;
+    impact.contacts++;
+}
+
+// Un solo recorrido por los puntos del contacto; el mismo impulso se
+// suma a los dos cuerpos (accion y reaccion)
+void ImpactStats::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    float maxImpulse = 0.0f;
+    float totalImpulse = 0.0f;
+    for (int i = 0; i < impulse->count; ++i)
+    {
+        maxImpulse = b2Max(maxImpulse, impulse->normalImpulses[i]);
+        totalImpulse += impulse->normalImpulses[i];
+    }
+    if (totalImpulse <= 0.0f)
+        return;
+
+    Accumulate(contact->GetFixtureA()->GetBody(), maxImpulse, totalImpulse);
+    Accumulate(contact->GetFixtureB()->GetBody(), maxImpulse, totalImpulse);
+}
+
+// Box2D avisa por cada fixture del cuerpo que se destruye; con la primera
+// alcanza para liberar el slot
+void ImpactStats::SayGoodbye(b2Fixture* fixture)
+{
+    Release(fixture->GetBody());
+}
+
+int ImpactStats::GetTopImpacts(int k, std::vector<BodyImpact>& out, float minImpulse) const
+{
+    out.clear();
+    for (int slot : touched)
+    {
+        const BodyImpact& impact = slots[slot];
+        if (impact.body && impact.maxImpulse >= minImpulse)
+            out.push_back(impact);
+    }
+
+    // Solo se ordenan los k primeros
+    int count = std::min(k, (int)out.size());
+    std::partial_sort(out.begin(), out.begin() + count, out.end(), [](const BodyImpact& a, const BodyImpact& b) {
+        return a.maxImpulse > b.maxImpulse;
+    });
+    out.resize(count);
+    return count;
+}
+
+BodyImpact ImpactStats::GetImpact(const b2Body* body) const
+{
+    int slot = GetSlot(body);
+    if (slot >= 0)
+        return slots[slot];
+
+    BodyImpact none;
+    none.body = nullptr;
+    none.maxImpulse = 0.0f;
+    none.totalImpulse = 0.0f;
+    none.contacts = 0;
+    return none;
+}
@@ -0,0 +1,282 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+// Hilo actual: a que sistema pertenece y su indice en el
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentIndex = 0;
+
+// Constructor de la clase JobSystem
+JobSystem::JobSystem(int threadCount)
+{
+    if (threadCount < 0)
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+    queued = 0;
+    sleepers = 0;
+    quit = false;
+
+    // Todos los hilos se crean despues de armar todas las colas: un hilo
+    // sin trabajo puede ir a robar a cualquiera apenas arranca
+    for (int i = 0; i <= threadCount; ++i)
+    {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->top = 0;
+        worker->bottom = 0;
+        worker->jobs.reset(new Job[JobsPerThread]);
+        worker->allocated = 0;
+        worker->executed = 0;
+        worker->stolen = 0;
+        workers.push_back(std::move(worker));
+    }
+    currentSystem = this;
+    currentIndex = 0;
+    for (int i = 1; i <= threadCount; ++i)
+        threads.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+}
+
+// Destructor: despierta a los hilos para que salgan y los espera
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+    if (currentSystem == this)
+        currentSystem = nullptr;
+}
+
+int JobSystem::GetThreadIndex() const
+{
+    return currentSystem == this ? currentIndex : 0;
+}
+
+Job* JobSystem::Create(const std::function<void()>& func, Job* parent)
+{
+    Worker& worker = *workers[GetThreadIndex()];
+    Job* job = &worker.jobs[worker.allocated++ % JobsPerThread];
+    job->func = func;
+    job->parent = parent;
+    job->unfinished = 1;
+    job->pending = 1;
+    job->continuationCount = 0;
+    job->relay = false;
+    if (parent)
+        parent->unfinished++;
+    return job;
+}
+
+void JobSystem::AddDependency(Job* job, Job* after)
+{
+    // Lista llena: el ltimo lugar pasa a una tarea vaca que depende de
+    // after y libera a la que estaba ah y a las que sigan llegando. No se
+    // puede esperar a after porque todava no se llam a Run
+    if (after->continuationCount == Job::MaxContinuations)
+    {
+        Job*& last = after->continuations[Job::MaxContinuations - 1];
+        if (!last->relay)
+        {
+            // El pending de Create queda como la espera de after: el relevo
+            // nunca pasa por Run y se encola cuando after termina
+            Job* relay = Create(nullptr);
+            relay->relay = true;
+            relay->continuations[relay->continuationCount++] = last;
+            last = relay;
+        }
+        AddDependency(job, last);
+        return;
+    }
+    job->pending++;
+    after->continuations[after->continuationCount++] = job;
+}
+
+void JobSystem::Run(Job* job)
+{
+    if (job->pending.fetch_sub(1) == 1)
+        Push(job);
+}
+
+// Encola en la cola del hilo actual y despierta a uno que duerma
+void JobSystem::Push(Job* job)
+{
+    int index = GetThreadIndex();
+    Worker& worker = *workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.bottom - worker.top < (unsigned int)JobsPerThread)
+        {
+            worker.queue[worker.bottom % JobsPerThread] = job;
+            worker.bottom++;
+            job = nullptr;
+        }
+    }
+    // Cola llena: la tarea corre ya en este hilo
+    if (job)
+    {
+        Execute(job, index);
+        return;
+    }
+
+    queued++;
+    if (sleepers > 0)
+    {
+        // Tomar el mutex asegura que el que va a dormir ya vio queued o ya
+        // est esperando y recibe el aviso
+        { std::lock_guard<std::mutex> lock(sleepMutex); }
+        wake.notify_one();
+    }
+}
+
+// El dueo saca lo ltimo que encol: es lo que tiene ms fresco en cache
+Job* JobSystem::Pop(int index)
+{
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.bottom == worker.top)
+        return nullptr;
+    worker.bottom--;
+    return worker.queue[worker.bottom % JobsPerThread];
+}
+
+// Los dems roban lo ms viejo, que suele ser el trabajo ms grande sin partir
+Job* JobSystem::Steal(int index)
+{
+    int count = (int)workers.size();
+    for (int i = 1; i < count; ++i)
+    {
+        Worker& victim = *workers[(index + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.bottom == victim.top)
+            continue;
+        Job* job = victim.queue[victim.top % JobsPerThread];
+        victim.top++;
+        workers[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+    return nullptr;
+}
+
+Job* JobSystem::GetJob(int index)
+{
+    Job* job = Pop(index);
+    if (!job)
+        job = Steal(index);
+    if (job)
+        queued--;
+    return job;
+}
+
+void JobSystem::Execute(Job* job, int index)
+{
+    if (job->func)
+        job->func();
+    workers[index]->executed.fetch_add(1, std::memory_order_relaxed);
+    Finish(job);
+}
+
+// La tarea o una de sus hijas termin. Cuando no queda ninguna se liberan
+// las que dependan de ella y se avisa al padre
+void JobSystem::Finish(Job* job)
+{
+    if (job->unfinished.fetch_sub(1) != 1)
+        return;
+    for (int i = 0; i < job->continuationCount; ++i)
+        Run(job->continuations[i]);
+    if (job->parent)
+        Finish(job->parent);
+}
+
+void JobSystem::Wait(Job* job)
+{
+    int index = GetThreadIndex();
+    while (job->unfinished > 0)
+    {
+        Job* next = GetJob(index);
+        if (next)
+            Execute(next, index);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+    currentSystem = this;
+    currentIndex = index;
+
+    // Antes de dormir se reintenta un rato: entre las tareas de un mismo
+    // frame hay huecos cortos y despertar un hilo cuesta ms que esperar
+    int idle = 0;
+    for (;;)
+    {
+        Job* job = GetJob(index);
+        if (job)
+        {
+            Execute(job, index);
+            idle = 0;
+            continue;
+        }
+        if (++idle < 64)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers++;
+        wake.wait(lock, [this] { return quit || queued > 0; });
+        sleepers--;
+        if (quit)
+            return;
+    }
+}
+
+void JobSystem::ParallelFor(int count, int minChunk, const std::function<void(int, int)>& func)
+{
+    if (count <= 0)
+        return;
+
+    // Lote chico o sin hilos extra: no vale la pena repartir
+    int threadCount = GetThreadCount();
+    if (threadCount == 1 || count <= minChunk)
+    {
+        func(0, count);
+        return;
+    }
+
+    // Cuatro bloques por hilo para que los que terminan antes roben
+    int chunkSize = std::max(minChunk, (count + threadCount * 4 - 1) / (threadCount * 4));
+    Job* root = Create(nullptr);
+    for (int begin = 0; begin < count; begin += chunkSize)
+    {
+        int end = std::min(begin + chunkSize, count);
+        Run(Create([&func, begin, end] { func(begin, end); }, root));
+    }
+    Run(root);
+    Wait(root);
+}
+
+JobStats JobSystem::GetStats() const
+{
+    JobStats stats;
+    stats.executed = 0;
+    stats.stolen = 0;
+    for (const std::unique_ptr<Worker>& worker : workers)
+    {
+        stats.executed += worker->executed.load(std::memory_order_relaxed);
+        stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void JobSystem::ResetStats()
+{
+    for (std::unique_ptr<Worker>& worker : workers)
+    {
+        worker->executed = 0;
+        worker->stolen = 0;
+    }
+}
@@ -0,0 +1,112 @@
+//-----------------------------------------------------
+//Sistema de tareas con robo de trabajo para repartir
+//el trabajo de cada frame. Cada hilo tiene su cola:
+//saca del fondo lo ultimo que encolo y, si no tiene
+//nada, le roba a otro hilo lo mas viejo de la suya.
+//Una tarea puede tener hijas (termina cuando terminan
+//todas) y dependencias (no arranca hasta que terminan
+//las tareas de las que depende). Se usa desde el hilo
+//que lo creo y desde adentro de sus tareas
+//-----------------------------------------------------
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Job
+{
+	static const int MaxContinuations = 8;
+
+	std::function<void()> func;		// Vacia: la tarea solo agrupa a sus hijas
+	Job* parent;
+	std::atomic<int> unfinished;	// Ella misma mas sus hijas sin terminar
+	std::atomic<int> pending;		// Dependencias sin cumplir, mas 1 hasta que se llama Run
+	Job* continuations[MaxContinuations];	// Tareas que dependen de esta
+	int continuationCount;
+	bool relay;						// Vacia, solo encadena continuaciones que no entraron
+};
+
+// Contadores desde el ultimo ResetStats, sumados entre todos los hilos
+struct JobStats
+{
+	int executed;
+	int stolen;		// Tareas que corrio un hilo distinto del que las encolo
+};
+
+class JobSystem
+{
+public:
+	// Tareas que un hilo puede tener creadas sin terminar. Los lugares se
+	// reciclan en orden, asi que no hay que pasarse entre dos Wait
+	static const int JobsPerThread = 1024;
+
+private:
+	// Datos de cada hilo; el del indice 0 es el que creo el sistema
+	struct Worker
+	{
+		std::mutex mutex;			// Protege la cola: casi nunca hay dos hilos en la misma
+		Job* queue[JobsPerThread];
+		unsigned int top;			// Lo mas viejo, de donde roban los demas
+		unsigned int bottom;		// Lo mas nuevo, de donde saca el dueo
+		std::unique_ptr<Job[]> jobs;
+		unsigned int allocated;
+		std::atomic<int> executed;
+		std::atomic<int> stolen;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::vector<std::thread> threads;
+
+	// Los hilos sin trabajo duermen hasta que se encola algo
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	std::atomic<int> queued;
+	std::atomic<int> sleepers;
+	bool quit;
+
+	int GetThreadIndex() const;
+	void Push(Job* job);
+	Job* Pop(int index);
+	Job* Steal(int index);
+	Job* GetJob(int index);
+	void Execute(Job* job, int index);
+	void Finish(Job* job);
+	void WorkerLoop(int index);
+
+public:
+	// threadCount: hilos extra ademas del que llama. Negativo usa los
+	// nucleos disponibles menos uno; 0 deja todo en el hilo que llama
+	JobSystem(int threadCount = -1);
+	~JobSystem();
+
+	// Hilos que ejecutan tareas, contando al que creo el sistema
+	int GetThreadCount() const { return (int)workers.size(); }
+
+	// Crea una tarea sin encolarla. Con parent, el padre no termina hasta
+	// que termine esta: se crea antes de Run(parent) o desde adentro del padre
+	Job* Create(const std::function<void()>& func, Job* parent = nullptr);
+
+	// job no arranca hasta que termine after. Se llama antes de Run de las dos.
+	// No hay limite: pasadas MaxContinuations se encadenan tareas vacias
+	void AddDependency(Job* job, Job* after);
+
+	// Encola la tarea; si tiene dependencias sin cumplir se encola sola
+	// cuando termina la ultima
+	void Run(Job* job);
+
+	// Espera a que termine la tarea ejecutando otras mientras tanto
+	void Wait(Job* job);
+
+	// Ejecuta func(begin, end) sobre [0, count) en bloques de al menos
+	// minChunk elementos y espera a que terminen. Se puede llamar desde
+	// adentro de una tarea
+	void ParallelFor(int count, int minChunk, const std::function<void(int, int)>& func);
+
+	JobStats GetStats() const;
+	void ResetStats();
+};
@@ -0,0 +1,39 @@
+//-----------------------------------------------------
+//Archivo mapeado en memoria de solo lectura. En Windows
+//usa CreateFileMapping/MapViewOfFile y en el resto
+//mmap. El contenido se lee en el lugar: el sistema trae
+//las paginas a medida que se tocan, sin copiar a un
+//buffer propio
+//-----------------------------------------------------
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+private:
+	const void* data;
+	size_t size;
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fd;
+#endif
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	// Mapea el archivo entero. Devuelve false si no existe o esta vacio
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+	const void* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+};
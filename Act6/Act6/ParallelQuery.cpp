@@ -0,0 +1,111 @@
+#include "ParallelQuery.h"
+#include <cassert>
+
+// Constructor de la clase ParallelQuery
+ParallelQuery::ParallelQuery(b2World* world, ThreadPool* threadPool, int chunk)
+{
+    phyWorld = world;
+    pool = threadPool;
+    jobs = nullptr;
+    minChunk = chunk;
+}
+
+// Mismas consultas repartidas en el sistema de tareas: se pueden pedir
+// desde adentro de una tarea del frame
+ParallelQuery::ParallelQuery(b2World* world, JobSystem* jobSystem, int chunk)
+{
+    phyWorld = world;
+    pool = nullptr;
+    jobs = jobSystem;
+    minChunk = chunk;
+}
+
+void ParallelQuery::Split(int count, int minChunk, const std::function<void(int, int)>& func)
+{
+    if (jobs)
+        jobs->ParallelFor(count, minChunk, func);
+    else
+        pool->ParallelFor(count, minChunk, func);
+}
+
+int ParallelQuery::RayCastClosest(const b2Vec2* from, const b2Vec2* to, int count, uint16 maskBits)
+{
+    // Dentro del Step el mundo se esta modificando
+    assert(!phyWorld->IsLocked());
+
+    hits.resize(count);
+    b2World* world = phyWorld;
+    RayHit* out = hits.data();
+
+    // Cada rayo escribe solo su propio resultado, no hace falta sincronizar
+    Split(count, minChunk, [world, out, from, to, maskBits](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+            RayHit& hit = out[i];
+            hit.fixture = nullptr;
+            hit.fraction = 1.0f;
+            SpatialQuery::ForEachRay(world, from[i], to[i], [&hit, maskBits](b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) {
+                if ((fixture->GetFilterData().categoryBits & maskBits) == 0)
+                    return -1.0f;
+                hit.fixture = fixture;
+                hit.point = point;
+                hit.normal = normal;
+                hit.fraction = fraction;
+                return fraction;
+            });
+        }
+    });
+
+    int hitCount = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (hits[i].fixture)
+            hitCount++;
+    }
+    return hitCount;
+}
+
+int ParallelQuery::QueryAABBs(const b2AABB* boxes, int count, uint16 maskBits)
+{
+    assert(!phyWorld->IsLocked());
+
+    // Bloques fijos de minChunk consultas, asi cada bloque sabe su indice
+    int chunkCount = (count + minChunk - 1) / minChunk;
+    if ((int)chunkFixtures.size() < chunkCount)
+        chunkFixtures.resize(chunkCount);
+    counts.resize(count);
+
+    b2World* world = phyWorld;
+    int chunkSize = minChunk;
+    std::vector<b2Fixture*>* chunks = chunkFixtures.data();
+    int* queryCounts = counts.data();
+
+    Split(chunkCount, 1, [world, boxes, count, chunkSize, chunks, queryCounts, maskBits](int begin, int end) {
+        for (int c = begin; c < end; ++c)
+        {
+            std::vector<b2Fixture*>& found = chunks[c];
+            found.clear();
+            int last = b2Min((c + 1) * chunkSize, count);
+            for (int i = c * chunkSize; i < last; ++i)
+            {
+                size_t before = found.size();
+                SpatialQuery::ForEachAABB(world, boxes[i], [&found, maskBits](b2Fixture* fixture) {
+                    if (fixture->GetFilterData().categoryBits & maskBits)
+                        found.push_back(fixture);
+                    return true;
+                });
+                queryCounts[i] = (int)(found.size() - before);
+            }
+        }
+    });
+
+    // Concatenar los bloques en el arreglo plano, en orden de consulta
+    fixtures.clear();
+    offsets.resize(count + 1);
+    offsets[0] = 0;
+    for (int i = 0; i < count; ++i)
+        offsets[i + 1] = offsets[i] + counts[i];
+    for (int c = 0; c < chunkCount; ++c)
+        fixtures.insert(fixtures.end(), chunkFixtures[c].begin(), chunkFixtures[c].end());
+    return (int)fixtures.size();
+}
@@ -0,0 +1,51 @@
+//-----------------------------------------------------
+//Lotes grandes de rayos y cajas repartidos en un pool
+//de hilos o en el sistema de tareas. Entre dos Step() el mundo solo se lee, asi
+//que las consultas pueden correr en paralelo. Las
+//llamadas bloquean hasta que terminan todos los hilos:
+//mientras tanto el hilo del juego no puede tocar el
+//mundo
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include "JobSystem.h"
+#include "SpatialQuery.h"
+#include "ThreadPool.h"
+
+class ParallelQuery
+{
+private:
+	b2World* phyWorld;
+	ThreadPool* pool;
+	JobSystem* jobs;	// Se usa uno de los dos
+	int minChunk;		// Consultas minimas por bloque
+
+	std::vector<RayHit> hits;
+
+	// Resultados de cajas: cada bloque llena su propio arreglo y al final
+	// se concatenan en orden
+	std::vector<std::vector<b2Fixture*>> chunkFixtures;
+	std::vector<int> counts;
+	std::vector<b2Fixture*> fixtures;
+	std::vector<int> offsets;
+
+	void Split(int count, int minChunk, const std::function<void(int, int)>& func);
+
+public:
+	// minChunk: por debajo de esta cantidad de consultas todo corre en el hilo que llama
+	ParallelQuery(b2World* world, ThreadPool* pool, int minChunk = 64);
+	ParallelQuery(b2World* world, JobSystem* jobs, int minChunk = 64);
+
+	// Primer impacto de cada rayo from[i] -> to[i]. Llamar despues de Step(),
+	// nunca desde un callback del mundo. Devuelve cuantos chocaron
+	int RayCastClosest(const b2Vec2* from, const b2Vec2* to, int count, uint16 maskBits = 0xFFFF);
+
+	// Fixtures cuyo AABB toca cada caja. Devuelve el total de resultados
+	int QueryAABBs(const b2AABB* boxes, int count, uint16 maskBits = 0xFFFF);
+
+	const RayHit& GetHit(int ray) const { return hits[ray]; }
+	int GetResultCount(int query) const { return offsets[query + 1] - offsets[query]; }
+	b2Fixture* const* GetResults(int query) const { return fixtures.data() + offsets[query]; }
+};
@@ -0,0 +1,227 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PARTICLES_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC acepta intrnsecos AVX2 sin /arch: solo ese ncleo usa esas instrucciones
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+// Integracin semi-implcita, la misma que hace b2World con sus cuerpos:
+// primero la velocidad y con la velocidad nueva la posicin
+static void IntegrateScalar(float* x, float* y, float* vx, float* vy, float* life, int begin, int end,
+    float timeStep, float gx, float gy)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        vx[i] += timeStep * gx;
+        vy[i] += timeStep * gy;
+        x[i] += timeStep * vx[i];
+        y[i] += timeStep * vy[i];
+        life[i] -= timeStep;
+    }
+}
+
+#ifdef PARTICLES_X86
+// De a 4 partculas; lo que sobra lo termina el escalar
+static int IntegrateSse(float* x, float* y, float* vx, float* vy, float* life, int count,
+    float timeStep, float gx, float gy)
+{
+    __m128 h = _mm_set1_ps(timeStep);
+    __m128 dvx = _mm_set1_ps(timeStep * gx);
+    __m128 dvy = _mm_set1_ps(timeStep * gy);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 velX = _mm_add_ps(_mm_loadu_ps(vx + i), dvx);
+        __m128 velY = _mm_add_ps(_mm_loadu_ps(vy + i), dvy);
+        _mm_storeu_ps(vx + i, velX);
+        _mm_storeu_ps(vy + i, velY);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(h, velX)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(h, velY)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), h));
+    }
+    return i;
+}
+
+// De a 8 partculas. Sin FMA a propsito: da los mismos resultados que el
+// escalar y el SSE
+AVX2_FUNCTION static int IntegrateAvx2(float* x, float* y, float* vx, float* vy, float* life, int count,
+    float timeStep, float gx, float gy)
+{
+    __m256 h = _mm256_set1_ps(timeStep);
+    __m256 dvx = _mm256_set1_ps(timeStep * gx);
+    __m256 dvy = _mm256_set1_ps(timeStep * gy);
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 velX = _mm256_add_ps(_mm256_loadu_ps(vx + i), dvx);
+        __m256 velY = _mm256_add_ps(_mm256_loadu_ps(vy + i), dvy);
+        _mm256_storeu_ps(vx + i, velX);
+        _mm256_storeu_ps(vy + i, velY);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(h, velX)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(h, velY)));
+        _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), h));
+    }
+    // Evita la penalidad al volver a cdigo SSE
+    _mm256_zeroupper();
+    return i;
+}
+
+static bool DetectAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    // AVX habilitado por el sistema operativo (guarda los registros de 256 bits)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+bool ParticleSystem::IsSupported(ParticleKernel kernel)
+{
+#ifdef PARTICLES_X86
+    static const bool avx2 = DetectAvx2();
+    return kernel == Kernel_Scalar || kernel == Kernel_Sse || (kernel == Kernel_Avx2 && avx2);
+#else
+    return kernel == Kernel_Scalar;
+#endif
+}
+
+const char* ParticleSystem::GetKernelName(ParticleKernel kernel)
+{
+    static const char* names[Kernel_Count] = { "escalar", "sse", "avx2" };
+    return (kernel >= 0 && kernel < Kernel_Count) ? names[kernel] : "desconocido";
+}
+
+// Constructor de la clase ParticleSystem: todo se reserva ac, despus
+// no hay ms pedidos de memoria salvo que crezca el arreglo de vrtices
+ParticleSystem::ParticleSystem(int maxParticles, float fade)
+    : vertices(sf::Points)
+{
+    capacity = maxParticles;
+    count = 0;
+    dropped = 0;
+    fadeTime = fade;
+    x.resize(capacity);
+    y.resize(capacity);
+    vx.resize(capacity);
+    vy.resize(capacity);
+    life.resize(capacity);
+    color.resize(capacity);
+    vertices.resize(capacity);
+    vertices.clear();
+
+    kernel = Kernel_Scalar;
+    for (int k = Kernel_Count - 1; k > Kernel_Scalar; --k)
+    {
+        if (IsSupported((ParticleKernel)k))
+        {
+            kernel = (ParticleKernel)k;
+            break;
+        }
+    }
+}
+
+bool ParticleSystem::SetKernel(ParticleKernel newKernel)
+{
+    if (!IsSupported(newKernel))
+        return false;
+    kernel = newKernel;
+    return true;
+}
+
+void ParticleSystem::Spawn(const b2Vec2& position, const b2Vec2& velocity, float seconds, const sf::Color& tint)
+{
+    if (count == capacity)
+    {
+        dropped++;
+        return;
+    }
+    x[count] = position.x;
+    y[count] = position.y;
+    vx[count] = velocity.x;
+    vy[count] = velocity.y;
+    life[count] = seconds;
+    color[count] = tint;
+    count++;
+}
+
+void ParticleSystem::SpawnBurst(const b2Vec2& position, float direction, float spread, float minSpeed, float maxSpeed,
+    int burstCount, float seconds, const sf::Color& tint)
+{
+    std::uniform_real_distribution<float> angle(direction - 0.5f * spread, direction + 0.5f * spread);
+    std::uniform_real_distribution<float> speed(minSpeed, maxSpeed);
+    std::uniform_real_distribution<float> jitter(0.5f, 1.0f);
+    for (int i = 0; i < burstCount; ++i)
+    {
+        float a = angle(rng);
+        Spawn(position, speed(rng) * b2Vec2(std::cos(a), std::sin(a)), seconds * jitter(rng), tint);
+    }
+}
+
+void ParticleSystem::Integrate(float timeStep, const b2Vec2& gravity)
+{
+    int done = 0;
+#ifdef PARTICLES_X86
+    if (kernel == Kernel_Avx2)
+        done = IntegrateAvx2(x.data(), y.data(), vx.data(), vy.data(), life.data(), count, timeStep, gravity.x, gravity.y);
+    else if (kernel == Kernel_Sse)
+        done = IntegrateSse(x.data(), y.data(), vx.data(), vy.data(), life.data(), count, timeStep, gravity.x, gravity.y);
+#endif
+    IntegrateScalar(x.data(), y.data(), vx.data(), vy.data(), life.data(), done, count, timeStep, gravity.x, gravity.y);
+}
+
+// Una sola pasada: cada partcula se copia a la posicin live y live avanza
+// solo si sigue viva, as las vencidas quedan pisadas sin un if por
+// partcula. En el mismo recorrido se escribe su vrtice
+void ParticleSystem::CompactAndEmit()
+{
+    vertices.resize(count);
+    float fadeRate = 1.0f / fadeTime;
+    int live = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        float remaining = life[i];
+        x[live] = x[i];
+        y[live] = y[i];
+        vx[live] = vx[i];
+        vy[live] = vy[i];
+        life[live] = remaining;
+        color[live] = color[i];
+
+        sf::Vertex& vertex = vertices[live];
+        vertex.position.x = x[i];
+        vertex.position.y = y[i];
+        vertex.color = color[i];
+        vertex.color.a = (sf::Uint8)(color[i].a * std::min(std::max(remaining * fadeRate, 0.0f), 1.0f));
+
+        live += (int)(remaining > 0.0f);
+    }
+    count = live;
+    vertices.resize(live);
+}
+
+void ParticleSystem::Update(float timeStep, const b2Vec2& gravity)
+{
+    Integrate(timeStep, gravity);
+    CompactAndEmit();
+}
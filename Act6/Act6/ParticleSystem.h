@@ -0,0 +1,76 @@
+//-----------------------------------------------------
+//Particulas de efecto (chispas, trazadoras, vainas)
+//que no chocan con nada y por eso no necesitan cuerpos
+//de Box2D. Se guardan como estructura de arreglos (un
+//arreglo por campo), se integran de a 4 u 8 con SSE o
+//AVX2 con la misma gravedad del mundo, y en la misma
+//pasada que descarta las vencidas se arma un solo
+//sf::VertexArray para dibujarlas todas juntas
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <random>
+#include <vector>
+
+// Nucleo de integracion. Update usa el mejor que soporta el procesador
+enum ParticleKernel
+{
+	Kernel_Scalar = 0,
+	Kernel_Sse,
+	Kernel_Avx2,
+	Kernel_Count
+};
+
+class ParticleSystem
+{
+private:
+	// Un arreglo por campo, todos de largo capacity
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> vx;
+	std::vector<float> vy;
+	std::vector<float> life;		// Segundos que le quedan
+	std::vector<sf::Color> color;
+	int count;
+	int capacity;
+	int dropped;					// Pedidas con el arreglo lleno
+
+	ParticleKernel kernel;
+	float fadeTime;					// Se desvanecen en los ultimos fadeTime segundos
+	sf::VertexArray vertices;
+	std::minstd_rand rng;
+
+	void Integrate(float timeStep, const b2Vec2& gravity);
+	void CompactAndEmit();
+
+public:
+	ParticleSystem(int capacity, float fadeTime = 0.25f);
+
+	// Agrega una particula; si no hay lugar se descarta y se cuenta
+	void Spawn(const b2Vec2& position, const b2Vec2& velocity, float life, const sf::Color& color);
+
+	// count particulas saliendo de position dentro de un cono de spread
+	// radianes alrededor de direction, con rapidez entre minSpeed y maxSpeed
+	void SpawnBurst(const b2Vec2& position, float direction, float spread, float minSpeed, float maxSpeed,
+		int count, float life, const sf::Color& color);
+
+	// Avanza timeStep segundos con la gravedad dada (la del mundo), descarta
+	// las vencidas y arma los vertices. No toca el mundo: puede correr en otro hilo
+	void Update(float timeStep, const b2Vec2& gravity);
+
+	// Un punto por particula viva, listo para dibujar
+	const sf::VertexArray& GetVertices() const { return vertices; }
+
+	void Clear() { count = 0; vertices.clear(); }
+	int GetCount() const { return count; }
+	int GetCapacity() const { return capacity; }
+	int GetDroppedCount() const { return dropped; }
+
+	// Para medir: fuerza un nucleo. Devuelve false si el procesador no lo soporta
+	bool SetKernel(ParticleKernel kernel);
+	ParticleKernel GetKernel() const { return kernel; }
+	static bool IsSupported(ParticleKernel kernel);
+	static const char* GetKernelName(ParticleKernel kernel);
+};
@@ -0,0 +1,168 @@
+#include "PhysicsCounters.h"
+#include <algorithm>
+#include <cstdio>
+
+// Constructor de la clase PhysicsCounters
+PhysicsCounters::PhysicsCounters()
+    : slots(new Slot[Capacity])
+{
+    for (int i = 0; i < Capacity; ++i)
+        slots[i].sequence = 0;
+    written = 0;
+}
+
+void PhysicsCounters::Push(const FrameCounters& counters)
+{
+    unsigned int index = written.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % Capacity];
+
+    // Impar: los lectores saben que el lugar est a medio escribir
+    unsigned int sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.data = counters;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    written.store(index + 1, std::memory_order_release);
+}
+
+int PhysicsCounters::CopyRecent(FrameCounters* out, int maxCount) const
+{
+    unsigned int end = written.load(std::memory_order_acquire);
+    unsigned int available = std::min(end, (unsigned int)Capacity);
+    unsigned int count = std::min(available, (unsigned int)std::max(maxCount, 0));
+
+    int copied = 0;
+    for (unsigned int index = end - count; index != end; ++index)
+    {
+        const Slot& slot = slots[index % Capacity];
+        unsigned int before = slot.sequence.load(std::memory_order_acquire);
+        FrameCounters copy = slot.data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        unsigned int after = slot.sequence.load(std::memory_order_relaxed);
+
+        // Se estaba escribiendo o ya se pis con un frame ms nuevo
+        if (before != after || (before & 1) != 0)
+            continue;
+        out[copied++] = copy;
+    }
+    return copied;
+}
+
+bool PhysicsCounters::GetLatest(FrameCounters& out) const
+{
+    return CopyRecent(&out, 1) == 1;
+}
+
+int PhysicsCounters::FindBody(b2Body* body) const
+{
+    auto it = std::lower_bound(bodies.begin(), bodies.end(), body);
+    return (it != bodies.end() && *it == body) ? (int)(it - bodies.begin()) : -1;
+}
+
+int PhysicsCounters::FindRoot(int index)
+{
+    while (parent[index] != index)
+    {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+// Islas como las arma el Step: cuerpos despiertos no estticos unidos por
+// contactos que se tocan (sin sensores) o por joints. Los estticos no
+// propagan la isla
+int PhysicsCounters::CountIslands(b2World* world)
+{
+    bodies.clear();
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (body->GetType() != b2_staticBody && body->IsAwake() && body->IsEnabled())
+            bodies.push_back(body);
+    }
+    std::sort(bodies.begin(), bodies.end());
+    parent.resize(bodies.size());
+    for (size_t i = 0; i < parent.size(); ++i)
+        parent[i] = (int)i;
+
+    int islands = (int)bodies.size();
+    auto join = [this, &islands](b2Body* a, b2Body* b) {
+        int ia = FindBody(a);
+        int ib = FindBody(b);
+        if (ia < 0 || ib < 0)
+            return;
+        ia = FindRoot(ia);
+        ib = FindRoot(ib);
+        if (ia != ib)
+        {
+            parent[ia] = ib;
+            islands--;
+        }
+    };
+
+    for (b2Contact* contact = world->GetContactList(); contact; contact = contact->GetNext())
+    {
+        if (!contact->IsTouching() || !contact->IsEnabled())
+            continue;
+        if (contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor())
+            continue;
+        join(contact->GetFixtureA()->GetBody(), contact->GetFixtureB()->GetBody());
+    }
+    for (b2Joint* joint = world->GetJointList(); joint; joint = joint->GetNext())
+        join(joint->GetBodyA(), joint->GetBodyB());
+    return islands;
+}
+
+void PhysicsCounters::Sample(b2World* world, int bulletsAlive, float frameMs)
+{
+    FrameCounters counters;
+    counters.frame = (int)written.load(std::memory_order_relaxed);
+    counters.frameMs = frameMs;
+    counters.bodyCount = world->GetBodyCount();
+    counters.contactCount = world->GetContactCount();
+    counters.proxyCount = world->GetProxyCount();
+    counters.treeHeight = world->GetTreeHeight();
+    counters.treeBalance = world->GetTreeBalance();
+    counters.treeQuality = world->GetTreeQuality();
+    counters.profile = world->GetProfile();
+
+    int movable = 0;
+    int awake = 0;
+    int bullets = 0;
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (body->GetType() == b2_staticBody)
+            continue;
+        movable++;
+        awake += body->IsAwake() ? 1 : 0;
+        bullets += body->IsBullet() ? 1 : 0;
+    }
+    counters.awakeBodies = awake;
+    counters.sleepingRatio = movable > 0 ? (float)(movable - awake) / movable : 0.0f;
+    counters.bullets = bulletsAlive >= 0 ? bulletsAlive : bullets;
+    counters.islands = CountIslands(world);
+    Push(counters);
+}
+
+bool PhysicsCounters::ExportCsv(const char* path) const
+{
+    std::vector<FrameCounters> frames(Capacity);
+    int count = CopyRecent(frames.data(), Capacity);
+
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+        return false;
+    std::fprintf(file, "frame,frame_ms,cuerpos,despiertos,islas,dormidos,balas,contactos,proxies,altura_arbol,balance_arbol,calidad_arbol,"
+        "paso_ms,colision_ms,resolucion_ms,inicio_ms,velocidad_ms,posicion_ms,broadphase_ms,toi_ms\n");
+    for (int i = 0; i < count; ++i)
+    {
+        const FrameCounters& c = frames[i];
+        const b2Profile& p = c.profile;
+        std::fprintf(file, "%d,%.3f,%d,%d,%d,%.3f,%d,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+            c.frame, c.frameMs, c.bodyCount, c.awakeBodies, c.islands, c.sleepingRatio, c.bullets, c.contactCount,
+            c.proxyCount, c.treeHeight, c.treeBalance, c.treeQuality, p.step, p.collide, p.solve, p.solveInit,
+            p.solveVelocity, p.solvePosition, p.broadphase, p.solveTOI);
+    }
+    return std::fclose(file) == 0;
+}
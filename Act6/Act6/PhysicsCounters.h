@@ -0,0 +1,79 @@
+//-----------------------------------------------------
+//Contadores de fisica por frame: lo que expone b2World
+//(cuerpos, contactos, proxies, arbol, b2Profile) mas
+//cuentas derivadas (despiertos, islas, proporcion de
+//dormidos, balas). Se guardan en un buffer circular
+//sin locks: escribe un solo hilo y se puede leer desde
+//cualquiera para graficar o exportar
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct FrameCounters
+{
+	int frame;
+	float frameMs;			// Duracion del frame completo, no solo del Step
+
+	// Directo de b2World
+	int bodyCount;
+	int contactCount;
+	int proxyCount;
+	int treeHeight;
+	int treeBalance;
+	float treeQuality;
+	b2Profile profile;		// Milisegundos de cada parte del ultimo Step
+
+	// Derivados
+	int awakeBodies;		// No estaticos despiertos
+	int islands;			// Grupos de despiertos unidos por contactos o joints
+	float sleepingRatio;	// Dormidos sobre no estaticos
+	int bullets;
+};
+
+class PhysicsCounters
+{
+public:
+	static const int Capacity = 1024;	// Frames guardados (potencia de 2)
+
+private:
+	// Cada lugar lleva un numero de secuencia: impar mientras se escribe.
+	// El lector copia y descarta la copia si la secuencia cambio en el medio
+	struct Slot
+	{
+		std::atomic<unsigned int> sequence;
+		FrameCounters data;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	std::atomic<unsigned int> written;	// Frames escritos desde el inicio
+
+	// Solo del escritor: cuerpos ordenados y union-find para las islas
+	std::vector<b2Body*> bodies;
+	std::vector<int> parent;
+
+	int FindBody(b2Body* body) const;
+	int FindRoot(int index);
+	int CountIslands(b2World* world);
+
+public:
+	PhysicsCounters();
+
+	// Escritor. Mide el mundo despues del Step y guarda el frame.
+	// bulletsAlive: balas que sigue el juego; con -1 se cuentan los cuerpos
+	// marcados con SetBullet
+	void Sample(b2World* world, int bulletsAlive, float frameMs);
+	void Push(const FrameCounters& counters);
+
+	// Lectores, desde cualquier hilo
+	bool GetLatest(FrameCounters& out) const;
+
+	// Copia hasta maxCount frames, del mas viejo al mas nuevo. Devuelve cuantos
+	int CopyRecent(FrameCounters* out, int maxCount) const;
+
+	// Todos los frames guardados en un CSV
+	bool ExportCsv(const char* path) const;
+};
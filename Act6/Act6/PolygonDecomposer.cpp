@@ -0,0 +1,365 @@
+#include "PolygonDecomposer.h"
+#include <algorithm>
+#include <cstring>
+
+// Tolerancias geometricas
+static const float kPointEpsilon = 1.0e-4f;		// Vertices mas cercanos que esto se consideran iguales
+static const float kCrossEpsilon = 1.0e-6f;		// Producto cruz debajo de esto es colineal
+static const float kMinPieceArea = b2_linearSlop * b2_linearSlop;	// Box2D rechaza piezas degeneradas
+
+// Producto cruz de (b - a) x (c - b): positivo si a, b, c giran en sentido antihorario
+static float Turn(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+{
+    return b2Cross(b - a, c - b);
+}
+
+// Cache compartida (estatica local para no depender del orden de inicializacion)
+std::unordered_multimap<uint64_t, PolygonDecomposer::CacheEntry>& PolygonDecomposer::Cache()
+{
+    static std::unordered_multimap<uint64_t, CacheEntry> cache;
+    return cache;
+}
+
+std::mutex& PolygonDecomposer::CacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::atomic<int>& PolygonDecomposer::Hits()
+{
+    static std::atomic<int> hits(0);
+    return hits;
+}
+
+std::atomic<int>& PolygonDecomposer::Misses()
+{
+    static std::atomic<int> misses(0);
+    return misses;
+}
+
+// Hash FNV-1a sobre los bits de los vertices
+uint64_t PolygonDecomposer::Hash(const b2Vec2* v, int n)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(v);
+    size_t size = sizeof(b2Vec2) * (size_t)n;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Area con signo (positiva en sentido antihorario)
+float PolygonDecomposer::SignedArea(const std::vector<b2Vec2>& points)
+{
+    float area = 0.0f;
+    size_t n = points.size();
+    for (size_t i = 0; i < n; ++i)
+        area += b2Cross(points[i], points[(i + 1) % n]);
+    return 0.5f * area;
+}
+
+// True si el poligono dado por indices (antihorario) es convexo
+bool PolygonDecomposer::IsConvexIndexed(const std::vector<b2Vec2>& points, const std::vector<int>& poly)
+{
+    size_t n = poly.size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const b2Vec2& a = points[poly[i]];
+        const b2Vec2& b = points[poly[(i + 1) % n]];
+        const b2Vec2& c = points[poly[(i + 2) % n]];
+        if (Turn(a, b, c) < -kCrossEpsilon)
+            return false;
+    }
+    return true;
+}
+
+// True si el poligono (en cualquier sentido de giro) es convexo
+bool PolygonDecomposer::IsConvex(const b2Vec2* v, int n)
+{
+    if (n < 3)
+        return false;
+    bool positive = false;
+    bool negative = false;
+    for (int i = 0; i < n; ++i)
+    {
+        float turn = Turn(v[i], v[(i + 1) % n], v[(i + 2) % n]);
+        if (turn > kCrossEpsilon)
+            positive = true;
+        else if (turn < -kCrossEpsilon)
+            negative = true;
+    }
+    return !(positive && negative);
+}
+
+// Triangulacion por recorte de orejas. Devuelve false si el poligono no es
+// simple (se cruza a si mismo) y no se pudo terminar
+bool PolygonDecomposer::Triangulate(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polys)
+{
+    std::vector<int> remaining(points.size());
+    for (size_t i = 0; i < remaining.size(); ++i)
+        remaining[i] = (int)i;
+
+    size_t i = 0;
+    size_t misses = 0;
+    while (remaining.size() > 3)
+    {
+        size_t n = remaining.size();
+        int prev = remaining[(i + n - 1) % n];
+        int cur = remaining[i % n];
+        int next = remaining[(i + 1) % n];
+        const b2Vec2& a = points[prev];
+        const b2Vec2& b = points[cur];
+        const b2Vec2& c = points[next];
+
+        bool ear = Turn(a, b, c) > kCrossEpsilon;
+        for (size_t k = 0; ear && k < n; ++k)
+        {
+            int other = remaining[k];
+            if (other == prev || other == cur || other == next)
+                continue;
+            const b2Vec2& p = points[other];
+            // Un vertice dentro (o sobre el borde) del triangulo invalida la oreja
+            if (b2Cross(b - a, p - a) >= 0.0f && b2Cross(c - b, p - b) >= 0.0f && b2Cross(a - c, p - c) >= 0.0f)
+                ear = false;
+        }
+
+        if (ear)
+        {
+            polys.push_back({ prev, cur, next });
+            remaining.erase(remaining.begin() + (i % n));
+            misses = 0;
+        }
+        else
+        {
+            i++;
+            // Dimos una vuelta entera sin encontrar orejas: el poligono no es simple
+            if (++misses > n)
+                return false;
+        }
+        i %= remaining.size();
+    }
+
+    polys.push_back(remaining);
+    return true;
+}
+
+// Hertel-Mehlhorn: recorre las diagonales de la triangulacion una vez y quita
+// las que no hacen falta para mantener la convexidad. El resultado tiene a lo
+// sumo 4 veces la cantidad minima de piezas, en O(n) sobre las diagonales
+void PolygonDecomposer::MergeTriangles(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polys)
+{
+    const uint64_t n = points.size();
+    auto key = [n](int a, int b) { return (uint64_t)a * n + (uint64_t)b; };
+
+    // Duenio de cada arista dirigida
+    std::unordered_map<uint64_t, int> owner;
+    for (size_t p = 0; p < polys.size(); ++p)
+    {
+        const std::vector<int>& poly = polys[p];
+        for (size_t k = 0; k < poly.size(); ++k)
+            owner[key(poly[k], poly[(k + 1) % poly.size()])] = (int)p;
+    }
+
+    // Diagonales internas: aristas que aparecen en los dos sentidos
+    std::vector<std::pair<int, int>> diagonals;
+    for (const auto& edge : owner)
+    {
+        int a = (int)(edge.first / n);
+        int b = (int)(edge.first % n);
+        if (a < b && owner.count(key(b, a)))
+            diagonals.push_back(std::make_pair(a, b));
+    }
+
+    std::vector<bool> alive(polys.size(), true);
+    for (const auto& diagonal : diagonals)
+    {
+        int a = diagonal.first;
+        int b = diagonal.second;
+        int p = owner[key(a, b)];
+        int q = owner[key(b, a)];
+        if (p == q || !alive[p] || !alive[q])
+            continue;
+
+        const std::vector<int>& pp = polys[p];
+        const std::vector<int>& qq = polys[q];
+        if (pp.size() + qq.size() - 2 > b2_maxPolygonVertices)
+            continue;
+
+        // P contiene la arista a->b y Q la arista b->a. Unimos P desde b hasta a
+        // con Q desde a hasta b, sin repetir los extremos
+        size_t pb = std::find(pp.begin(), pp.end(), b) - pp.begin();
+        size_t qa = std::find(qq.begin(), qq.end(), a) - qq.begin();
+        std::vector<int> merged;
+        for (size_t k = 0; k < pp.size(); ++k)
+            merged.push_back(pp[(pb + k) % pp.size()]);
+        for (size_t k = 1; k + 1 < qq.size(); ++k)
+            merged.push_back(qq[(qa + k) % qq.size()]);
+
+        if (!IsConvexIndexed(points, merged))
+            continue;
+
+        polys[p] = merged;
+        alive[q] = false;
+        for (size_t k = 0; k < merged.size(); ++k)
+            owner[key(merged[k], merged[(k + 1) % merged.size()])] = p;
+    }
+
+    std::vector<std::vector<int>> result;
+    for (size_t p = 0; p < polys.size(); ++p)
+    {
+        if (alive[p])
+            result.push_back(polys[p]);
+    }
+    polys.swap(result);
+}
+
+// Agrega una pieza si no es degenerada
+void PolygonDecomposer::EmitPiece(const std::vector<b2Vec2>& points, const std::vector<int>& poly, std::vector<ConvexPiece>& pieces)
+{
+    if (poly.size() < 3 || poly.size() > b2_maxPolygonVertices)
+        return;
+
+    ConvexPiece piece;
+    piece.count = (int)poly.size();
+    std::vector<b2Vec2> verts(poly.size());
+    for (size_t k = 0; k < poly.size(); ++k)
+    {
+        piece.vertices[k] = points[poly[k]];
+        verts[k] = points[poly[k]];
+    }
+
+    if (SignedArea(verts) > kMinPieceArea)
+        pieces.push_back(piece);
+}
+
+// Calcula la descomposicion sin pasar por la cache
+void PolygonDecomposer::Compute(const b2Vec2* v, int n, std::vector<ConvexPiece>& pieces)
+{
+    // Limpiar vertices repetidos consecutivos (incluido el cierre)
+    std::vector<b2Vec2> points;
+    for (int i = 0; i < n; ++i)
+    {
+        if (points.empty() || b2DistanceSquared(points.back(), v[i]) > kPointEpsilon * kPointEpsilon)
+            points.push_back(v[i]);
+    }
+    if (points.size() > 1 && b2DistanceSquared(points.front(), points.back()) <= kPointEpsilon * kPointEpsilon)
+        points.pop_back();
+    if (points.size() < 3)
+        return;
+
+    // Box2D espera los vertices en sentido antihorario
+    if (SignedArea(points) < 0.0f)
+        std::reverse(points.begin(), points.end());
+
+    // Quitar vertices colineales, no aportan y confunden a la triangulacion
+    for (size_t i = 0; points.size() > 3 && i < points.size();)
+    {
+        size_t m = points.size();
+        if (b2Abs(Turn(points[(i + m - 1) % m], points[i], points[(i + 1) % m])) <= kCrossEpsilon)
+            points.erase(points.begin() + i);
+        else
+            i++;
+    }
+
+    std::vector<int> all(points.size());
+    for (size_t i = 0; i < all.size(); ++i)
+        all[i] = (int)i;
+
+    if (IsConvexIndexed(points, all))
+    {
+        // Convexo: abanico desde el vertice 0 en piezas de hasta 8 vertices,
+        // que es la cantidad minima posible
+        if (all.size() <= b2_maxPolygonVertices)
+        {
+            EmitPiece(points, all, pieces);
+            return;
+        }
+        for (size_t start = 1; start + 1 < all.size(); start += b2_maxPolygonVertices - 2)
+        {
+            std::vector<int> fan;
+            fan.push_back(0);
+            for (size_t k = start; k < all.size() && fan.size() < b2_maxPolygonVertices; ++k)
+                fan.push_back((int)k);
+            EmitPiece(points, fan, pieces);
+        }
+        return;
+    }
+
+    std::vector<std::vector<int>> polys;
+    if (!Triangulate(points, polys))
+        return;
+    MergeTriangles(points, polys);
+    for (const std::vector<int>& poly : polys)
+        EmitPiece(points, poly, pieces);
+}
+
+// Entrada de la cache con estos vertices, o nullptr. Se llama con el mutex tomado
+const std::vector<ConvexPiece>* PolygonDecomposer::Find(uint64_t hash, const b2Vec2* v, int n)
+{
+    auto range = Cache().equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const std::vector<b2Vec2>& source = it->second.source;
+        if ((int)source.size() == n && std::memcmp(source.data(), v, sizeof(b2Vec2) * n) == 0)
+            return &it->second.pieces;
+    }
+    return nullptr;
+}
+
+// Devuelve las piezas convexas del poligono, usando la cache. El calculo
+// se hace sin el mutex; si otro hilo guardo el mismo poligono mientras
+// tanto, gana el que ya estaba
+const std::vector<ConvexPiece>& PolygonDecomposer::Decompose(const b2Vec2* v, int n)
+{
+    uint64_t hash = Hash(v, n);
+    {
+        std::lock_guard<std::mutex> lock(CacheMutex());
+        const std::vector<ConvexPiece>* cached = Find(hash, v, n);
+        if (cached)
+        {
+            Hits()++;
+            return *cached;
+        }
+    }
+
+    Misses()++;
+    CacheEntry entry;
+    entry.source.assign(v, v + n);
+    Compute(v, n, entry.pieces);
+
+    std::lock_guard<std::mutex> lock(CacheMutex());
+    const std::vector<ConvexPiece>* cached = Find(hash, v, n);
+    if (cached)
+        return *cached;
+    // Las referencias a elementos de un unordered_multimap sobreviven al rehash
+    return Cache().emplace(hash, std::move(entry))->second.pieces;
+}
+
+// Vacia la cache
+void PolygonDecomposer::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(CacheMutex());
+    Cache().clear();
+    Hits() = 0;
+    Misses() = 0;
+}
+
+int PolygonDecomposer::GetCacheSize()
+{
+    std::lock_guard<std::mutex> lock(CacheMutex());
+    return (int)Cache().size();
+}
+
+int PolygonDecomposer::GetCacheHits()
+{
+    return Hits();
+}
+
+int PolygonDecomposer::GetCacheMisses()
+{
+    return Misses();
+}
@@ -0,0 +1,66 @@
+//-----------------------------------------------------
+//Descompone poligonos simples (concavos o con mas de
+//b2_maxPolygonVertices vertices) en piezas convexas que
+//Box2D acepta. Los resultados se guardan en una cache
+//indexada por el hash de los vertices, protegida con un
+//mutex: las escenas se arman tambien desde los hilos de
+//BatchSimulator
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Pieza convexa lista para pasarle a b2PolygonShape::Set
+struct ConvexPiece
+{
+	int count;
+	b2Vec2 vertices[b2_maxPolygonVertices];
+};
+
+class PolygonDecomposer
+{
+private:
+	// Entrada de la cache: guardamos los vertices originales para
+	// descartar colisiones de hash
+	struct CacheEntry
+	{
+		std::vector<b2Vec2> source;
+		std::vector<ConvexPiece> pieces;
+	};
+
+	static std::unordered_multimap<uint64_t, CacheEntry>& Cache();
+	static std::mutex& CacheMutex();
+	static std::atomic<int>& Hits();
+	static std::atomic<int>& Misses();
+
+	static uint64_t Hash(const b2Vec2* v, int n);
+	static const std::vector<ConvexPiece>* Find(uint64_t hash, const b2Vec2* v, int n);
+	static float SignedArea(const std::vector<b2Vec2>& points);
+	static bool IsConvexIndexed(const std::vector<b2Vec2>& points, const std::vector<int>& poly);
+	static bool Triangulate(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polys);
+	static void MergeTriangles(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polys);
+	static void EmitPiece(const std::vector<b2Vec2>& points, const std::vector<int>& poly, std::vector<ConvexPiece>& pieces);
+	static void Compute(const b2Vec2* v, int n, std::vector<ConvexPiece>& pieces);
+
+public:
+	// Devuelve las piezas convexas del poligono. La primera vez se calculan
+	// (O(n^2)) y las siguientes se sirven desde la cache. Se puede llamar
+	// desde cualquier hilo; la referencia vale hasta el proximo ClearCache.
+	// Vacia si el poligono se cruza a si mismo o no tiene 3 puntos distintos
+	static const std::vector<ConvexPiece>& Decompose(const b2Vec2* v, int n);
+
+	// True si el poligono (en cualquier sentido de giro) es convexo
+	static bool IsConvex(const b2Vec2* v, int n);
+
+	// Estadisticas y manejo de la cache. ClearCache invalida las piezas
+	// devueltas: no se llama mientras otro hilo arma una escena
+	static void ClearCache();
+	static int GetCacheSize();
+	static int GetCacheHits();
+	static int GetCacheMisses();
+};
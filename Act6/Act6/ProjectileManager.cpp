@@ -0,0 +1,129 @@
+#include "ProjectileManager.h"
+#include "Box2DHelper.h"
+#include "CollisionLayers.h"
+#include <algorithm>
+#include <cmath>
+
+// Constructor de la clase ProjectileManager
+ProjectileManager::ProjectileManager(b2World* world, const b2AABB& worldBounds, float ttl)
+{
+    phyWorld = world;
+    bounds = worldBounds;
+    timeToLive = ttl;
+    restSpeed = 0.5f;	// Debajo de 0.5 m/s la bala se considera quieta
+    restMinAge = 0.5f;	// ...pero solo despues de medio segundo de vida
+    restFrames = 20;	// ...y durante 20 frames seguidos: un tiro casi vertical pasa
+                        // por el punto mas alto en unos 6 frames y no se descarta ahi
+    for (int i = 0; i < Despawn_ReasonCount; ++i)
+        despawned[i] = 0;
+}
+
+// Crea una bala (mismo cuerpo que usaba Game::Shoot) y la empieza a seguir
+b2Body* ProjectileManager::Spawn(const b2Vec2& position, float angle, float speed, float now, ProjectileKind kind)
+{
+    b2Body* bullet = Box2DHelper::CreateCircularDynamicBody(phyWorld, 0.5f, 1.0f, 0.2f, 0.1f);
+    bullet->SetTransform(position, angle);
+    CollisionLayers::Apply(bullet, Layer_Projectile); // No choca con el can ni con otras balas
+    bullet->SetLinearVelocity(b2Vec2(std::cos(angle) * speed, std::sin(angle) * speed));
+    bullet->GetFixtureList()->GetUserData().pointer = (uintptr_t)kind;
+
+    Track(bullet, now);
+    return bullet;
+}
+
+ProjectileKind ProjectileManager::GetKind(b2Fixture* fixture)
+{
+    if (!fixture || fixture->GetFilterData().categoryBits != CollisionLayers::Category(Layer_Projectile))
+        return Projectile_Normal;
+    return (ProjectileKind)fixture->GetUserData().pointer;
+}
+
+void ProjectileManager::Defuse(b2Fixture* fixture)
+{
+    fixture->GetUserData().pointer = (uintptr_t)Projectile_Normal;
+}
+
+// Empieza a seguir una bala
+void ProjectileManager::Track(b2Body* bullet, float now)
+{
+    Projectile projectile;
+    projectile.body = bullet;
+    projectile.spawnTime = now;
+    projectile.slowFrames = 0;
+    live.push_back(projectile);
+}
+
+// Pedido de destruccion diferida
+void ProjectileManager::Despawn(b2Body* bullet)
+{
+    requested.push_back(bullet);
+}
+
+// Saca la bala de la lista de vivas (swap con la ultima) y la deja pendiente
+void ProjectileManager::Remove(size_t index, DespawnReason reason)
+{
+    pending.push_back(live[index].body);
+    despawned[reason]++;
+    live[index] = live.back();
+    live.pop_back();
+}
+
+// Revisa todas las balas una vez y destruye en lote las que ya no sirven
+void ProjectileManager::Update(float now)
+{
+    pending.clear();
+    std::sort(requested.begin(), requested.end());
+
+    for (size_t i = 0; i < live.size();)
+    {
+        Projectile& projectile = live[i];
+        b2Body* body = projectile.body;
+        const b2Vec2& pos = body->GetPosition();
+        float age = now - projectile.spawnTime;
+        bool slow = body->GetLinearVelocity().LengthSquared() < restSpeed * restSpeed;
+        projectile.slowFrames = slow ? projectile.slowFrames + 1 : 0;
+
+        if (!requested.empty() && std::binary_search(requested.begin(), requested.end(), body))
+            Remove(i, Despawn_Requested);
+        else if (pos.x < bounds.lowerBound.x || pos.x > bounds.upperBound.x || pos.y < bounds.lowerBound.y || pos.y > bounds.upperBound.y)
+            Remove(i, Despawn_OutOfBounds);
+        else if (age > timeToLive)
+            Remove(i, Despawn_Expired);
+        else if (age > restMinAge && (!body->IsAwake() || projectile.slowFrames >= restFrames))
+            Remove(i, Despawn_AtRest);
+        else
+            i++;
+    }
+    requested.clear();
+
+    // Destruccion en lote, fuera del Step
+    for (b2Body* body : pending)
+        phyWorld->DestroyBody(body);
+}
+
+// Destruye todas las balas vivas
+void ProjectileManager::Clear()
+{
+    for (const Projectile& projectile : live)
+        phyWorld->DestroyBody(projectile.body);
+    live.clear();
+    requested.clear();
+}
+
+// Total de balas destruidas por cualquier motivo
+int ProjectileManager::GetDespawnedCount() const
+{
+    int total = 0;
+    for (int i = 0; i < Despawn_ReasonCount; ++i)
+        total += despawned[i];
+    return total;
+}
+
+// Copia las balas vivas en out y devuelve cuantas son
+int ProjectileManager::GetBodies(std::vector<b2Body*>& out) const
+{
+    out.clear();
+    for (const Projectile& projectile : live)
+        out.push_back(projectile.body);
+    return (int)out.size();
+}
@@ -0,0 +1,90 @@
+//-----------------------------------------------------
+//Administra el ciclo de vida de las balas: las crea,
+//las sigue desde que se disparan y las destruye en lote
+//despues del Step() cuando salen del mundo, vencen o
+//quedan quietas, para que el mundo no crezca sin fin
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Motivos por los que se destruye una bala
+enum DespawnReason
+{
+	Despawn_OutOfBounds = 0,
+	Despawn_Expired,
+	Despawn_AtRest,
+	Despawn_Requested,
+	Despawn_ReasonCount
+};
+
+// Tipo de bala, guardado en userData.pointer de su fixture para leerlo
+// directo desde los eventos de contacto
+enum ProjectileKind
+{
+	Projectile_Normal = 0,
+	Projectile_Explosive
+};
+
+class ProjectileManager
+{
+private:
+	struct Projectile
+	{
+		b2Body* body;
+		float spawnTime;
+		int slowFrames;		// Updates seguidos debajo de restSpeed
+	};
+
+	b2World* phyWorld;
+	b2AABB bounds;
+	float timeToLive;
+	float restSpeed;
+	float restMinAge;
+	int restFrames;
+
+	std::vector<Projectile> live;
+	std::vector<b2Body*> requested;
+	std::vector<b2Body*> pending;
+	int despawned[Despawn_ReasonCount];
+
+	void Remove(size_t index, DespawnReason reason);
+
+public:
+	// bounds: caja del mundo fuera de la cual la bala se descarta
+	// timeToLive: segundos de vida maxima de cada bala
+	ProjectileManager(b2World* world, const b2AABB& bounds, float timeToLive);
+
+	// Crea una bala circular en la posicion dada con la velocidad del disparo
+	b2Body* Spawn(const b2Vec2& position, float angle, float speed, float now, ProjectileKind kind = Projectile_Normal);
+
+	// Tipo de bala de la fixture (Projectile_Normal si no es una bala o si
+	// es nullptr, como en un evento de contacto de una fixture ya destruida)
+	static ProjectileKind GetKind(b2Fixture* fixture);
+
+	// Vuelve normal una bala explosiva, para que explote una sola vez
+	static void Defuse(b2Fixture* fixture);
+
+	// Empieza a seguir una bala creada por otro lado
+	void Track(b2Body* bullet, float now);
+
+	// Pide destruir una bala (por ejemplo desde una colision). La destruccion
+	// queda diferida hasta el proximo Update
+	void Despawn(b2Body* bullet);
+
+	// Se llama despues de Step(): marca las balas a descartar y las destruye
+	// todas juntas, con el mundo desbloqueado
+	void Update(float now);
+
+	// Destruye todas las balas vivas
+	void Clear();
+
+	// Contadores
+	int GetLiveCount() const { return (int)live.size(); }
+	int GetDespawnedCount() const;
+	int GetDespawnedCount(DespawnReason reason) const { return despawned[reason]; }
+
+	// Las balas vivas, por ejemplo para dibujarlas
+	int GetBodies(std::vector<b2Body*>& out) const;
+};
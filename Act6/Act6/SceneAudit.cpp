@@ -0,0 +1,344 @@
+#include "SceneAudit.h"
+#include <algorithm>
+#include <cstdio>
+
+// Modelo de costo aproximado (microsegundos por paso, 8 iteraciones de
+// velocidad y 8 de posicion). Son valores orientativos para ordenar los
+// hallazgos, no una medicion: lo importante es el orden de magnitud.
+static const float kBodyStepUs = 0.35f;		// Integrar y resolver un cuerpo despierto
+static const float kContactStepUs = 0.6f;	// Narrowphase + solver de un contacto tocando
+static const float kProxyMoveUs = 0.25f;	// Reubicar un proxy en el arbol del broadphase
+
+// Tolerancias para decidir si un cuerpo se movio o fue teletransportado
+static const float kMoveEpsilon = 1.0e-4f;
+static const float kTeleportEpsilon = 1.0e-3f;
+
+// Constructor de la clase SceneAudit
+SceneAudit::SceneAudit(void)
+{
+    frames = 0;
+}
+
+// Olvida todo lo observado
+void SceneAudit::Reset()
+{
+    tracks.clear();
+    frames = 0;
+}
+
+// Sigue el movimiento de cada cuerpo entre dos pasos consecutivos
+void SceneAudit::Observe(b2World* phyWorld, float timeStep)
+{
+    frames++;
+    size_t seen = 0;
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        auto it = tracks.find(body);
+        if (it == tracks.end())
+        {
+            // Primera vez que vemos el cuerpo: solo guardamos su estado
+            BodyTrack track;
+            track.position = body->GetPosition();
+            track.angle = body->GetAngle();
+            track.observedFrames = 1;
+            track.lastSeenFrame = frames;
+            track.awakeFrames = body->IsAwake() ? 1 : 0;
+            track.teleports = 0;
+            track.moved = false;
+            tracks[body] = track;
+            seen++;
+            continue;
+        }
+
+        BodyTrack& track = it->second;
+        b2Vec2 position = body->GetPosition();
+        float angle = body->GetAngle();
+
+        if (b2DistanceSquared(position, track.position) > kMoveEpsilon * kMoveEpsilon || b2Abs(angle - track.angle) > kMoveEpsilon)
+            track.moved = true;
+
+        // Un cinematico solo deberia moverse lo que dice su velocidad (el paso no
+        // la modifica). Si el desplazamiento no coincide, alguien lo movio con
+        // SetTransform
+        if (body->GetType() == b2_kinematicBody)
+        {
+            b2Vec2 predicted = track.position + timeStep * body->GetLinearVelocity();
+            float predictedAngle = track.angle + timeStep * body->GetAngularVelocity();
+            if (b2Distance(position, predicted) > kTeleportEpsilon || b2Abs(angle - predictedAngle) > kTeleportEpsilon)
+                track.teleports++;
+        }
+
+        track.position = position;
+        track.angle = angle;
+        track.observedFrames++;
+        track.lastSeenFrame = frames;
+        if (body->IsAwake())
+            track.awakeFrames++;
+        seen++;
+    }
+
+    // Olvidar los cuerpos destruidos (balas descartadas, etc.) para que el
+    // mapa no crezca con cada disparo
+    if (tracks.size() > seen)
+    {
+        for (auto it = tracks.begin(); it != tracks.end();)
+        {
+            if (it->second.lastSeenFrame != frames)
+                it = tracks.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+// Cantidad de contactos que estan tocando al cuerpo
+int SceneAudit::CountTouchingContacts(const b2Body* body)
+{
+    int count = 0;
+    for (b2ContactEdge* edge = const_cast<b2Body*>(body)->GetContactList(); edge; edge = edge->next)
+    {
+        if (edge->contact->IsTouching())
+            count++;
+    }
+    return count;
+}
+
+// Cantidad de fixtures del cuerpo
+int SceneAudit::CountFixtures(const b2Body* body)
+{
+    int count = 0;
+    for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        count++;
+    return count;
+}
+
+// True si todas las fixtures del cuerpo tienen densidad cero
+bool SceneAudit::HasOnlyZeroDensity(const b2Body* body)
+{
+    const b2Fixture* fixture = body->GetFixtureList();
+    if (!fixture)
+        return false;
+    for (; fixture; fixture = fixture->GetNext())
+    {
+        if (fixture->GetDensity() > 0.0f)
+            return false;
+    }
+    return true;
+}
+
+// Las fabricas estaticas y cinematicas de Box2DHelper crean las fixtures con
+// densidad, friccion y restitucion en cero. Un dinamico con esa firma casi
+// seguro salio de una de ellas (por ejemplo CreatePolyStaticBody)
+bool SceneAudit::LooksLikeStaticFactory(const b2Body* body)
+{
+    if (!HasOnlyZeroDensity(body))
+        return false;
+    for (const b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+    {
+        if (fixture->GetFriction() != 0.0f || fixture->GetRestitution() != 0.0f)
+            return false;
+    }
+    return true;
+}
+
+// Callback del broadphase que junta las fixtures estaticas que tocan un AABB
+class StaticOverlapCallback : public b2QueryCallback
+{
+public:
+    const b2Fixture* source;
+    std::vector<const b2Fixture*> hits;
+
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        const b2Body* body = fixture->GetBody();
+        // Solo pares de cuerpos estaticos distintos, y cada par una sola vez
+        if (body->GetType() == b2_staticBody && body > source->GetBody())
+            hits.push_back(fixture);
+        return true;
+    }
+};
+
+// Busca fixtures estaticas que se superponen usando el arbol del broadphase,
+// asi el costo es O(n log n) y no O(n^2)
+void SceneAudit::CheckOverlappingStatics(b2World* phyWorld, std::vector<AuditFinding>& findings) const
+{
+    StaticOverlapCallback callback;
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        if (body->GetType() != b2_staticBody)
+            continue;
+
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            callback.source = fixture;
+            callback.hits.clear();
+            phyWorld->QueryAABB(&callback, fixture->GetAABB(0));
+
+            for (const b2Fixture* other : callback.hits)
+            {
+                if (!b2TestOverlap(fixture->GetShape(), 0, other->GetShape(), 0, body->GetTransform(), other->GetBody()->GetTransform()))
+                    continue;
+
+                AuditFinding finding;
+                finding.kind = Audit_OverlappingStatics;
+                finding.severity = Severity_Info;
+                finding.body = body;
+                finding.other = other->GetBody();
+                // Los pares estatico-estatico no generan contactos; solo cuestan
+                // proxies de mas cuando un dinamico pasa por la zona
+                finding.costUs = kProxyMoveUs;
+                char buffer[160];
+                std::snprintf(buffer, sizeof(buffer), "estaticos superpuestos en (%.1f, %.1f) y (%.1f, %.1f), se pueden unir en un solo cuerpo",
+                    body->GetPosition().x, body->GetPosition().y, other->GetBody()->GetPosition().x, other->GetBody()->GetPosition().y);
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+        }
+    }
+}
+
+// Recorre el mundo y arma la lista de hallazgos
+std::vector<AuditFinding> SceneAudit::Run(b2World* phyWorld) const
+{
+    std::vector<AuditFinding> findings;
+    char buffer[200];
+
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        auto it = tracks.find(body);
+        const BodyTrack* track = (it != tracks.end()) ? &it->second : nullptr;
+        int contacts = CountTouchingContacts(body);
+        int fixtures = CountFixtures(body);
+        b2Vec2 pos = body->GetPosition();
+
+        AuditFinding finding;
+        finding.body = body;
+        finding.other = nullptr;
+
+        if (body->GetType() == b2_dynamicBody)
+        {
+            if (LooksLikeStaticFactory(body))
+            {
+                finding.kind = Audit_WrongBodyType;
+                finding.severity = Severity_Error;
+                finding.costUs = kBodyStepUs + contacts * kContactStepUs;
+                std::snprintf(buffer, sizeof(buffer), "cuerpo dinamico en (%.1f, %.1f) con fixtures de fabrica estatica (densidad, friccion y restitucion 0); deberia ser b2_staticBody", pos.x, pos.y);
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+            else if (HasOnlyZeroDensity(body))
+            {
+                finding.kind = Audit_ZeroMassDynamic;
+                finding.severity = Severity_Warning;
+                finding.costUs = kBodyStepUs + contacts * kContactStepUs;
+                std::snprintf(buffer, sizeof(buffer), "cuerpo dinamico en (%.1f, %.1f) con densidad 0, Box2D le asigna masa %.1f kg", pos.x, pos.y, body->GetMass());
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+
+            bool neverSleeps = !body->IsSleepingAllowed() ||
+                (track && track->observedFrames >= NeverSleepsFrames && track->awakeFrames == track->observedFrames);
+            if (neverSleeps)
+            {
+                finding.kind = Audit_NeverSleeps;
+                finding.severity = Severity_Warning;
+                finding.costUs = kBodyStepUs + contacts * kContactStepUs;
+                if (!body->IsSleepingAllowed())
+                    std::snprintf(buffer, sizeof(buffer), "cuerpo dinamico en (%.1f, %.1f) con allowSleep en false", pos.x, pos.y);
+                else
+                    std::snprintf(buffer, sizeof(buffer), "cuerpo dinamico en (%.1f, %.1f) despierto los %d pasos observados", pos.x, pos.y, track->observedFrames);
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+        }
+        else if (body->GetType() == b2_kinematicBody && track)
+        {
+            if (track->teleports > 0)
+            {
+                finding.kind = Audit_KinematicTeleport;
+                finding.severity = Severity_Warning;
+                // Cada SetTransform reubica los proxies y obliga a recalcular sus contactos
+                float rate = (float)track->teleports / (float)b2Max(track->observedFrames - 1, 1);
+                finding.costUs = rate * (fixtures * kProxyMoveUs + contacts * kContactStepUs);
+                std::snprintf(buffer, sizeof(buffer), "cuerpo cinematico en (%.1f, %.1f) movido con SetTransform en %d de %d pasos; usar SetLinearVelocity/SetAngularVelocity",
+                    pos.x, pos.y, track->teleports, track->observedFrames - 1);
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+            else if (!track->moved && track->observedFrames > 1)
+            {
+                finding.kind = Audit_WrongBodyType;
+                finding.severity = Severity_Info;
+                finding.costUs = fixtures * kProxyMoveUs;
+                std::snprintf(buffer, sizeof(buffer), "cuerpo cinematico en (%.1f, %.1f) que no se movio en %d pasos; podria ser estatico", pos.x, pos.y, track->observedFrames);
+                finding.detail = buffer;
+                findings.push_back(finding);
+            }
+        }
+    }
+
+    CheckOverlappingStatics(phyWorld, findings);
+
+    std::stable_sort(findings.begin(), findings.end(), [](const AuditFinding& a, const AuditFinding& b) {
+        if (a.severity != b.severity)
+            return a.severity > b.severity;
+        return a.costUs > b.costUs;
+    });
+    return findings;
+}
+
+// Nombre legible de cada tipo de hallazgo
+const char* SceneAudit::KindName(AuditKind kind)
+{
+    switch (kind)
+    {
+    case Audit_WrongBodyType: return "tipo-equivocado";
+    case Audit_ZeroMassDynamic: return "dinamico-sin-masa";
+    case Audit_KinematicTeleport: return "cinematico-teletransportado";
+    case Audit_OverlappingStatics: return "estaticos-superpuestos";
+    case Audit_NeverSleeps: return "nunca-duerme";
+    default: return "desconocido";
+    }
+}
+
+// Nombre legible de cada gravedad
+const char* SceneAudit::SeverityName(AuditSeverity severity)
+{
+    switch (severity)
+    {
+    case Severity_Info: return "info";
+    case Severity_Warning: return "aviso";
+    case Severity_Error: return "error";
+    default: return "?";
+    }
+}
+
+// Imprime los hallazgos, uno por linea, y el costo total estimado
+void SceneAudit::Print(const std::vector<AuditFinding>& findings, std::ostream& out)
+{
+    float total = 0.0f;
+    for (const AuditFinding& finding : findings)
+    {
+        char cost[32];
+        std::snprintf(cost, sizeof(cost), "%.2f", finding.costUs);
+        out << "[" << SeverityName(finding.severity) << "] " << KindName(finding.kind)
+            << " (~" << cost << " us/paso): " << finding.detail << "\n";
+        total += finding.costUs;
+    }
+
+    char summary[96];
+    std::snprintf(summary, sizeof(summary), "%d hallazgos, costo estimado %.2f us/paso\n", (int)findings.size(), total);
+    out << summary;
+}
+
+// Cantidad de hallazgos con gravedad mayor o igual a la indicada
+int SceneAudit::CountAtLeast(const std::vector<AuditFinding>& findings, AuditSeverity severity)
+{
+    int count = 0;
+    for (const AuditFinding& finding : findings)
+    {
+        if (finding.severity >= severity)
+            count++;
+    }
+    return count;
+}
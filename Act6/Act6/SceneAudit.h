@@ -0,0 +1,88 @@
+//-----------------------------------------------------
+//Auditoria de escenas: recorre el b2World y marca las
+//configuraciones de cuerpos que cuestan tiempo de paso
+//sin aportar nada (tipos equivocados, cuerpos que nunca
+//duermen, cinematicos teletransportados, etc.)
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tipos de hallazgo que reporta la auditoria
+enum AuditKind
+{
+	Audit_WrongBodyType = 0,	// Cuerpo creado con un tipo que no corresponde
+	Audit_ZeroMassDynamic,		// Dinamico con densidad cero (Box2D le fuerza masa 1)
+	Audit_KinematicTeleport,	// Cinematico movido con SetTransform en vez de velocidad
+	Audit_OverlappingStatics,	// Estaticos superpuestos (geometria duplicada)
+	Audit_NeverSleeps			// Dinamico que nunca se duerme
+};
+
+// Gravedad del hallazgo, para decidir si falla el chequeo de CI
+enum AuditSeverity
+{
+	Severity_Info = 0,
+	Severity_Warning,
+	Severity_Error
+};
+
+struct AuditFinding
+{
+	AuditKind kind;
+	AuditSeverity severity;
+	const b2Body* body;
+	const b2Body* other;	// Solo para Audit_OverlappingStatics
+	float costUs;			// Costo estimado por paso en microsegundos
+	std::string detail;
+};
+
+class SceneAudit
+{
+private:
+	// Lo que se recuerda de cada cuerpo entre pasos
+	struct BodyTrack
+	{
+		b2Vec2 position;
+		float angle;
+		int observedFrames;
+		int lastSeenFrame;
+		int awakeFrames;
+		int teleports;
+		bool moved;
+	};
+
+	std::unordered_map<const b2Body*, BodyTrack> tracks;
+	int frames;
+
+	static int CountTouchingContacts(const b2Body* body);
+	static int CountFixtures(const b2Body* body);
+	static bool HasOnlyZeroDensity(const b2Body* body);
+	static bool LooksLikeStaticFactory(const b2Body* body);
+	void CheckOverlappingStatics(b2World* phyWorld, std::vector<AuditFinding>& findings) const;
+
+public:
+	// Frames minimos despierto para considerar que un cuerpo "nunca duerme"
+	// (Box2D duerme un cuerpo quieto a los 0.5 s, le damos 4 s de margen)
+	static const int NeverSleepsFrames = 240;
+
+	SceneAudit(void);
+
+	// Se llama despues de cada Step() para seguir el movimiento de los cuerpos
+	void Observe(b2World* phyWorld, float timeStep);
+
+	// Olvida todo lo observado (por ejemplo al recargar la escena)
+	void Reset();
+
+	// Recorre el mundo y devuelve los hallazgos, ordenados por costo
+	std::vector<AuditFinding> Run(b2World* phyWorld) const;
+
+	// Utilidades para reportar
+	static const char* KindName(AuditKind kind);
+	static const char* SeverityName(AuditSeverity severity);
+	static void Print(const std::vector<AuditFinding>& findings, std::ostream& out);
+	static int CountAtLeast(const std::vector<AuditFinding>& findings, AuditSeverity severity);
+};
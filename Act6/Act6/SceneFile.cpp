@@ -0,0 +1,576 @@
+#include "SceneFile.h"
+#include "CollisionLayers.h"
+#include "PolygonDecomposer.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <vector>
+#include <sstream>
+
+static const char sceneMagic[4] = { 'E', 'S', 'C', 'B' };
+static const uint32 sceneVersion = 2;	// 2: offsets en la cabecera y arreglos alineados
+
+// Material con nombre del formato de texto
+struct SceneMaterial
+{
+    float density;
+    float friction;
+    float restitution;
+};
+
+void SceneData::Clear()
+{
+    gravity.Set(0.0f, 9.8f);
+    controlBody = -1;
+    bodies.clear();
+    fixtures.clear();
+}
+
+// Arma el mensaje "linea N: ..."
+static bool Fail(std::string& error, int line, const std::string& message)
+{
+    error = "linea " + std::to_string(line) + ": " + message;
+    return false;
+}
+
+static bool ParseLayer(const std::string& name, int32& layer)
+{
+    for (int i = 0; i < Layer_Count; ++i)
+    {
+        if (name == CollisionLayers::GetName((CollisionLayer)i))
+        {
+            layer = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static SceneFixture MakeFixture(SceneShapeType shape, const SceneMaterial& material)
+{
+    SceneFixture fixture = {};
+    fixture.shape = shape;
+    fixture.density = material.density;
+    fixture.friction = material.friction;
+    fixture.restitution = material.restitution;
+    return fixture;
+}
+
+bool SceneFile::LoadText(const std::string& path, SceneData& data, std::string& error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "no se pudo abrir " + path;
+        return false;
+    }
+
+    data.Clear();
+    std::map<std::string, SceneMaterial> materials;
+    std::string text;
+    int lineNumber = 0;
+
+    while (std::getline(file, text))
+    {
+        lineNumber++;
+        size_t comment = text.find('#');
+        if (comment != std::string::npos)
+            text.erase(comment);
+
+        std::istringstream line(text);
+        std::string keyword;
+        if (!(line >> keyword))
+            continue;
+
+        // Instrucciones que no dependen de un cuerpo
+        if (keyword == "gravedad")
+        {
+            if (!(line >> data.gravity.x >> data.gravity.y))
+                return Fail(error, lineNumber, "se esperaba gravedad <x> <y>");
+            continue;
+        }
+        if (keyword == "material")
+        {
+            std::string name;
+            SceneMaterial material;
+            if (!(line >> name >> material.density >> material.friction >> material.restitution))
+                return Fail(error, lineNumber, "se esperaba material <nombre> <densidad> <friccion> <restitucion>");
+            materials[name] = material;
+            continue;
+        }
+        if (keyword == "cuerpo")
+        {
+            std::string type;
+            SceneBody body = {};
+            body.layer = -1;
+            body.firstFixture = (int32)data.fixtures.size();
+            if (!(line >> type >> body.position.x >> body.position.y))
+                return Fail(error, lineNumber, "se esperaba cuerpo <tipo> <x> <y> [angulo] [control]");
+
+            if (type == "estatico")
+                body.type = b2_staticBody;
+            else if (type == "cinematico")
+                body.type = b2_kinematicBody;
+            else if (type == "dinamico")
+                body.type = b2_dynamicBody;
+            else
+                return Fail(error, lineNumber, "tipo de cuerpo desconocido: " + type);
+
+            // Angulo y marca de control opcionales
+            std::string extra;
+            while (line >> extra)
+            {
+                char* end;
+                float degrees = std::strtof(extra.c_str(), &end);
+                if (extra == "control")
+                    data.controlBody = (int32)data.bodies.size();
+                else if (*end == '\0')
+                    body.angle = degrees * b2_pi / 180.0f;
+                else
+                    return Fail(error, lineNumber, "se esperaba un angulo o control: " + extra);
+            }
+            data.bodies.push_back(body);
+            continue;
+        }
+
+        // El resto se aplica al ultimo cuerpo
+        if (data.bodies.empty())
+            return Fail(error, lineNumber, keyword + " antes del primer cuerpo");
+        SceneBody& body = data.bodies.back();
+
+        if (keyword == "velocidad")
+        {
+            if (!(line >> body.linearVelocity.x >> body.linearVelocity.y))
+                return Fail(error, lineNumber, "se esperaba velocidad <vx> <vy> [angular]");
+            line >> body.angularVelocity;
+            continue;
+        }
+        if (keyword == "capa")
+        {
+            std::string name;
+            if (!(line >> name) || !ParseLayer(name, body.layer))
+                return Fail(error, lineNumber, "capa desconocida");
+            continue;
+        }
+
+        // Fixtures: la forma, sus medidas y el material
+        std::string materialName;
+        SceneFixture fixture;
+        if (keyword == "caja")
+        {
+            float width, height;
+            if (!(line >> width >> height >> materialName))
+                return Fail(error, lineNumber, "se esperaba caja <ancho> <alto> <material>");
+            if (!materials.count(materialName))
+                return Fail(error, lineNumber, "material desconocido: " + materialName);
+            fixture = MakeFixture(SceneShape_Box, materials[materialName]);
+            fixture.width = width;
+            fixture.height = height;
+            data.fixtures.push_back(fixture);
+        }
+        else if (keyword == "circulo")
+        {
+            float radius;
+            if (!(line >> radius >> materialName))
+                return Fail(error, lineNumber, "se esperaba circulo <radio> <material>");
+            if (!materials.count(materialName))
+                return Fail(error, lineNumber, "material desconocido: " + materialName);
+            fixture = MakeFixture(SceneShape_Circle, materials[materialName]);
+            fixture.radius = radius;
+            data.fixtures.push_back(fixture);
+        }
+        else if (keyword == "poligono")
+        {
+            int count;
+            if (!(line >> materialName >> count) || count < 3)
+                return Fail(error, lineNumber, "se esperaba poligono <material> <n> <x1> <y1> ...");
+            if (!materials.count(materialName))
+                return Fail(error, lineNumber, "material desconocido: " + materialName);
+            std::vector<b2Vec2> points(count);
+            for (int i = 0; i < count; ++i)
+            {
+                if (!(line >> points[i].x >> points[i].y))
+                    return Fail(error, lineNumber, "faltan vertices");
+            }
+
+            // Se guardan solo piezas convexas, asi la carga no descompone nada
+            fixture = MakeFixture(SceneShape_Polygon, materials[materialName]);
+            if (count <= b2_maxPolygonVertices && PolygonDecomposer::IsConvex(points.data(), count))
+            {
+                fixture.vertexCount = count;
+                for (int i = 0; i < count; ++i)
+                    fixture.vertices[i] = points[i];
+                data.fixtures.push_back(fixture);
+            }
+            else
+            {
+                const std::vector<ConvexPiece>& pieces = PolygonDecomposer::Decompose(points.data(), count);
+                if (pieces.empty())
+                    return Fail(error, lineNumber, "poligono invalido (se cruza a si mismo)");
+                for (const ConvexPiece& piece : pieces)
+                {
+                    fixture.vertexCount = piece.count;
+                    for (int i = 0; i < piece.count; ++i)
+                        fixture.vertices[i] = piece.vertices[i];
+                    data.fixtures.push_back(fixture);
+                }
+            }
+        }
+        else
+        {
+            return Fail(error, lineNumber, "instruccion desconocida: " + keyword);
+        }
+        body.fixtureCount = (int32)data.fixtures.size() - body.firstFixture;
+    }
+    return true;
+}
+
+bool SceneFile::SaveText(const std::string& path, const SceneData& data, std::string& error)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+    {
+        error = "no se pudo crear " + path;
+        return false;
+    }
+
+    // Un material por cada combinacion distinta de densidad, friccion y restitucion
+    std::vector<SceneMaterial> materials;
+    std::vector<int> fixtureMaterial(data.fixtures.size());
+    for (size_t i = 0; i < data.fixtures.size(); ++i)
+    {
+        const SceneFixture& fixture = data.fixtures[i];
+        size_t m = 0;
+        while (m < materials.size() && (materials[m].density != fixture.density || materials[m].friction != fixture.friction || materials[m].restitution != fixture.restitution))
+            m++;
+        if (m == materials.size())
+            materials.push_back({ fixture.density, fixture.friction, fixture.restitution });
+        fixtureMaterial[i] = (int)m;
+    }
+
+    std::fprintf(file, "gravedad %g %g\n", data.gravity.x, data.gravity.y);
+    for (size_t m = 0; m < materials.size(); ++m)
+        std::fprintf(file, "material m%d %g %g %g\n", (int)m, materials[m].density, materials[m].friction, materials[m].restitution);
+
+    static const char* typeNames[] = { "estatico", "cinematico", "dinamico" };
+    for (size_t i = 0; i < data.bodies.size(); ++i)
+    {
+        const SceneBody& body = data.bodies[i];
+        std::fprintf(file, "cuerpo %s %g %g %g%s\n", typeNames[body.type], body.position.x, body.position.y,
+            body.angle * 180.0f / b2_pi, (int32)i == data.controlBody ? " control" : "");
+        if (body.linearVelocity.x != 0.0f || body.linearVelocity.y != 0.0f || body.angularVelocity != 0.0f)
+            std::fprintf(file, "velocidad %g %g %g\n", body.linearVelocity.x, body.linearVelocity.y, body.angularVelocity);
+        if (body.layer >= 0)
+            std::fprintf(file, "capa %s\n", CollisionLayers::GetName((CollisionLayer)body.layer));
+
+        for (int f = body.firstFixture; f < body.firstFixture + body.fixtureCount; ++f)
+        {
+            const SceneFixture& fixture = data.fixtures[f];
+            if (fixture.shape == SceneShape_Box)
+                std::fprintf(file, "caja %g %g m%d\n", fixture.width, fixture.height, fixtureMaterial[f]);
+            else if (fixture.shape == SceneShape_Circle)
+                std::fprintf(file, "circulo %g m%d\n", fixture.radius, fixtureMaterial[f]);
+            else
+            {
+                std::fprintf(file, "poligono m%d %d", fixtureMaterial[f], fixture.vertexCount);
+                for (int v = 0; v < fixture.vertexCount; ++v)
+                    std::fprintf(file, " %g %g", fixture.vertices[v].x, fixture.vertices[v].y);
+                std::fprintf(file, "\n");
+            }
+        }
+    }
+
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    if (!ok)
+        error = "error al escribir " + path;
+    return ok;
+}
+
+static uint32 Align16(size_t offset)
+{
+    return (uint32)((offset + 15) & ~(size_t)15);
+}
+
+// Cabecera valida para un archivo de fileSize bytes (o para la lectura con
+// fread, con fileSize = 0 no se controla el largo)
+static bool CheckHeader(const SceneFileHeader& header, size_t fileSize, const std::string& path, std::string& error)
+{
+    if (std::memcmp(header.magic, sceneMagic, sizeof(sceneMagic)) != 0)
+        error = path + " no es una escena binaria";
+    else if (header.version != sceneVersion || header.headerSize != sizeof(SceneFileHeader))
+        error = path + ": version " + std::to_string(header.version) + " no soportada";
+    else if (header.bodyCount < 0 || header.fixtureCount < 0 || (header.bodyOffset & 15) != 0 || (header.fixtureOffset & 15) != 0)
+        error = path + ": cabecera invalida";
+    else if (fileSize != 0 && (header.bodyOffset + (size_t)header.bodyCount * sizeof(SceneBody) > fileSize
+        || header.fixtureOffset + (size_t)header.fixtureCount * sizeof(SceneFixture) > fileSize))
+        error = path + ": archivo truncado";
+    else
+        return true;
+    return false;
+}
+
+// Cada cuerpo tiene que tener un tipo y una capa que existan y apuntar a
+// fixtures que existan, con formas conocidas y poligonos validos. Si no
+// Build() leeria fuera de los arreglos (o de la tabla de capas)
+static bool CheckRanges(const SceneBody* bodies, int bodyCount, const SceneFixture* fixtures, int fixtureCount, const std::string& path, std::string& error)
+{
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        const SceneBody& body = bodies[i];
+        if (body.type < b2_staticBody || body.type > b2_dynamicBody)
+        {
+            error = path + ": el cuerpo " + std::to_string(i) + " tiene un tipo invalido";
+            return false;
+        }
+        if (body.layer < -1 || body.layer >= Layer_Count)
+        {
+            error = path + ": el cuerpo " + std::to_string(i) + " tiene una capa invalida";
+            return false;
+        }
+        if (body.firstFixture < 0 || body.fixtureCount < 0 || body.firstFixture > fixtureCount - body.fixtureCount)
+        {
+            error = path + ": el cuerpo " + std::to_string(i) + " apunta fuera de las fixtures";
+            return false;
+        }
+    }
+    for (int f = 0; f < fixtureCount; ++f)
+    {
+        if (fixtures[f].shape < SceneShape_Box || fixtures[f].shape > SceneShape_Polygon)
+        {
+            error = path + ": la fixture " + std::to_string(f) + " tiene una forma desconocida";
+            return false;
+        }
+        if (fixtures[f].shape == SceneShape_Polygon && (fixtures[f].vertexCount < 3 || fixtures[f].vertexCount > b2_maxPolygonVertices))
+        {
+            error = path + ": la fixture " + std::to_string(f) + " es un poligono invalido";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SceneFile::SaveBinary(const std::string& path, const SceneData& data, std::string& error)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        error = "no se pudo crear " + path;
+        return false;
+    }
+
+    SceneFileHeader header = {};
+    std::memcpy(header.magic, sceneMagic, sizeof(sceneMagic));
+    header.version = sceneVersion;
+    header.headerSize = sizeof(SceneFileHeader);
+    header.bodyCount = (int32)data.bodies.size();
+    header.fixtureCount = (int32)data.fixtures.size();
+    header.controlBody = data.controlBody;
+    header.gravity = data.gravity;
+    header.bodyOffset = Align16(sizeof(SceneFileHeader));
+    header.fixtureOffset = Align16(header.bodyOffset + data.bodies.size() * sizeof(SceneBody));
+
+    // Relleno con ceros hasta cada offset
+    static const char padding[16] = {};
+    size_t bodiesEnd = header.bodyOffset + data.bodies.size() * sizeof(SceneBody);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && header.bodyOffset > sizeof(header))
+        ok = std::fwrite(padding, 1, header.bodyOffset - sizeof(header), file) == header.bodyOffset - sizeof(header);
+    if (ok && header.bodyCount > 0)
+        ok = std::fwrite(data.bodies.data(), sizeof(SceneBody), data.bodies.size(), file) == data.bodies.size();
+    if (ok && header.fixtureOffset > bodiesEnd)
+        ok = std::fwrite(padding, 1, header.fixtureOffset - bodiesEnd, file) == header.fixtureOffset - bodiesEnd;
+    if (ok && header.fixtureCount > 0)
+        ok = std::fwrite(data.fixtures.data(), sizeof(SceneFixture), data.fixtures.size(), file) == data.fixtures.size();
+    std::fclose(file);
+
+    if (!ok)
+        error = "error al escribir " + path;
+    return ok;
+}
+
+bool SceneFile::LoadBinary(const std::string& path, SceneData& data, std::string& error)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        error = "no se pudo abrir " + path;
+        return false;
+    }
+
+    SceneFileHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1;
+    if (!ok)
+        error = path + " no es una escena binaria";
+    else
+        ok = CheckHeader(header, 0, path, error);
+
+    if (ok)
+    {
+        // Los arreglos se leen de una sola vez, sin parsear
+        data.gravity = header.gravity;
+        data.controlBody = header.controlBody;
+        data.bodies.resize(header.bodyCount);
+        data.fixtures.resize(header.fixtureCount);
+        if (header.bodyCount > 0)
+            ok = std::fseek(file, header.bodyOffset, SEEK_SET) == 0
+                && std::fread(data.bodies.data(), sizeof(SceneBody), header.bodyCount, file) == (size_t)header.bodyCount;
+        if (ok && header.fixtureCount > 0)
+            ok = std::fseek(file, header.fixtureOffset, SEEK_SET) == 0
+                && std::fread(data.fixtures.data(), sizeof(SceneFixture), header.fixtureCount, file) == (size_t)header.fixtureCount;
+        if (!ok)
+            error = path + ": archivo truncado";
+        else
+            ok = CheckRanges(data.bodies.data(), header.bodyCount, data.fixtures.data(), header.fixtureCount, path, error);
+    }
+
+    std::fclose(file);
+    return ok;
+}
+
+bool SceneFile::MapBinary(const std::string& path, MappedFile& file, SceneView& view, std::string& error)
+{
+    if (!file.Open(path))
+    {
+        error = "no se pudo mapear " + path;
+        return false;
+    }
+
+    const char* base = (const char*)file.GetData();
+    const SceneFileHeader* header = (const SceneFileHeader*)base;
+    if (file.GetSize() < sizeof(SceneFileHeader) || !CheckHeader(*header, file.GetSize(), path, error))
+    {
+        if (error.empty())
+            error = path + " no es una escena binaria";
+        file.Close();
+        return false;
+    }
+
+    // Nada se copia: la vista apunta dentro del mapeo
+    view.header = header;
+    view.bodies = (const SceneBody*)(base + header->bodyOffset);
+    view.fixtures = (const SceneFixture*)(base + header->fixtureOffset);
+    view.bodyCount = header->bodyCount;
+    view.fixtureCount = header->fixtureCount;
+    if (!CheckRanges(view.bodies, view.bodyCount, view.fixtures, view.fixtureCount, path, error))
+    {
+        file.Close();
+        return false;
+    }
+    return true;
+}
+
+bool SceneFile::IsBinary(const std::string& path)
+{
+    char magic[4] = {};
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    size_t read = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+    return read == sizeof(magic) && std::memcmp(magic, sceneMagic, sizeof(sceneMagic)) == 0;
+}
+
+bool SceneFile::Load(const std::string& path, SceneData& data, std::string& error)
+{
+    if (IsBinary(path))
+        return LoadBinary(path, data, error);
+    return LoadText(path, data, error);
+}
+
+// Posicion, angulo y velocidades finales van en la definicion: el cuerpo
+// nace donde tiene que estar y no hace falta SetTransform despues
+b2BodyDef SceneFile::MakeBodyDef(const SceneBody& body)
+{
+    b2BodyDef bodyDef;
+    bodyDef.type = (b2BodyType)body.type;
+    bodyDef.position = body.position;
+    bodyDef.angle = body.angle;
+    bodyDef.linearVelocity = body.linearVelocity;
+    bodyDef.angularVelocity = body.angularVelocity;
+    return bodyDef;
+}
+
+// Filtro de la capa del cuerpo (o la de su tipo si no tiene)
+b2Filter SceneFile::MakeFilter(const SceneBody& body)
+{
+    CollisionLayer layer = body.layer >= 0 ? (CollisionLayer)body.layer : CollisionLayers::DefaultLayer((b2BodyType)body.type);
+    return CollisionLayers::MakeFilter(layer);
+}
+
+void SceneFile::CreateFixture(b2Body* body, const SceneBody& sceneBody, const SceneFixture& fixture)
+{
+    b2FixtureDef fixtureDef;
+    fixtureDef.density = fixture.density;
+    fixtureDef.friction = fixture.friction;
+    fixtureDef.restitution = fixture.restitution;
+    fixtureDef.filter = MakeFilter(sceneBody);
+
+    // Shapes en el stack: CreateFixture las clona
+    b2PolygonShape polygon;
+    b2CircleShape circle;
+    switch (fixture.shape)
+    {
+    case SceneShape_Box:
+        polygon.SetAsBox(fixture.width / 2.0f, fixture.height / 2.0f);
+        fixtureDef.shape = &polygon;
+        break;
+    case SceneShape_Circle:
+        circle.m_radius = fixture.radius;
+        fixtureDef.shape = &circle;
+        break;
+    case SceneShape_Polygon:
+        polygon.Set(fixture.vertices, fixture.vertexCount);
+        fixtureDef.shape = &polygon;
+        break;
+    default:
+        return; // CheckRanges ya descarta los archivos con formas desconocidas
+    }
+    body->CreateFixture(&fixtureDef);
+}
+
+b2Body* SceneFile::CreateBody(b2World* phyWorld, const SceneBody& sceneBody, const SceneFixture* fixtures)
+{
+    b2BodyDef bodyDef = MakeBodyDef(sceneBody);
+    b2Body* body = phyWorld->CreateBody(&bodyDef);
+    for (int f = 0; f < sceneBody.fixtureCount; ++f)
+        CreateFixture(body, sceneBody, fixtures[sceneBody.firstFixture + f]);
+    return body;
+}
+
+b2Body* SceneFile::Build(const SceneData& data, b2World* phyWorld, std::vector<b2Body*>* created)
+{
+    return Build(data.bodies.data(), (int)data.bodies.size(), data.fixtures.data(), data.controlBody, data.gravity, phyWorld, created);
+}
+
+b2Body* SceneFile::Build(const SceneView& view, b2World* phyWorld, std::vector<b2Body*>* created)
+{
+    return Build(view.bodies, view.bodyCount, view.fixtures, view.header->controlBody, view.header->gravity, phyWorld, created);
+}
+
+b2Body* SceneFile::Build(const SceneBody* bodies, int bodyCount, const SceneFixture* fixtures, int32 controlBody, const b2Vec2& gravity, b2World* phyWorld, std::vector<b2Body*>* created)
+{
+    phyWorld->SetGravity(gravity);
+    if (created)
+    {
+        created->clear();
+        created->reserve(bodyCount);
+    }
+
+    b2Body* control = nullptr;
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        b2Body* body = CreateBody(phyWorld, bodies[i], fixtures);
+        if (created)
+            created->push_back(body);
+        if (i == controlBody)
+            control = body;
+    }
+
+    // El cuerpo de control sin capa explcita es del jugador, no de la capa de su tipo
+    if (control && bodies[controlBody].layer < 0)
+        CollisionLayers::Apply(control, Layer_Player);
+    return control;
+}
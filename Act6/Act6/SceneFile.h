@@ -0,0 +1,143 @@
+//-----------------------------------------------------
+//Escenas descriptas en archivos en vez de armadas a
+//mano en InitPhysics(). Hay una forma de texto para
+//editar y una binaria compilada (la misma estructura
+//copiada tal cual) que se carga sin parsear o se mapea
+//en memoria y se lee en el lugar. Build()
+//crea el mundo en una pasada, con la transformacion y
+//la velocidad finales ya puestas en cada b2BodyDef
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// Formato de texto (una instruccion por linea, # comenta):
+//
+//   gravedad <x> <y>
+//   material <nombre> <densidad> <friccion> <restitucion>
+//   cuerpo <estatico|cinematico|dinamico> <x> <y> [angulo en grados] [control]
+//   velocidad <vx> <vy> [angular]
+//   capa <mundo|jugador|proyectil|enemigo|sensor>
+//   caja <ancho> <alto> <material>
+//   circulo <radio> <material>
+//   poligono <material> <n> <x1> <y1> ... <xn> <yn>
+//
+// velocidad, capa y las fixtures se aplican al ultimo cuerpo. Los
+// poligonos concavos o de mas de 8 vertices se parten al compilar
+
+enum SceneShapeType
+{
+	SceneShape_Box = 0,
+	SceneShape_Circle,
+	SceneShape_Polygon
+};
+
+// Fixture con el material ya resuelto. Solo tipos de tamao fijo: el
+// archivo binario es un arreglo de estas estructuras
+struct SceneFixture
+{
+	int32 shape;			// SceneShapeType
+	int32 vertexCount;		// Solo poligonos (convexos, hasta b2_maxPolygonVertices)
+	float density;
+	float friction;
+	float restitution;
+	float width;			// Cajas
+	float height;
+	float radius;			// Circulos
+	b2Vec2 vertices[b2_maxPolygonVertices];
+};
+
+struct SceneBody
+{
+	int32 type;				// b2BodyType
+	int32 layer;			// CollisionLayer, -1 usa la capa por defecto del tipo
+	int32 firstFixture;		// Indice en SceneData::fixtures
+	int32 fixtureCount;
+	b2Vec2 position;
+	float angle;			// Radianes
+	b2Vec2 linearVelocity;
+	float angularVelocity;
+};
+
+struct SceneData
+{
+	b2Vec2 gravity;
+	int32 controlBody;		// Indice del cuerpo de control, -1 si no hay
+	std::vector<SceneBody> bodies;
+	std::vector<SceneFixture> fixtures;
+
+	SceneData() : gravity(0.0f, 9.8f), controlBody(-1) {}
+	void Clear();
+};
+
+// Cabecera del archivo binario. El archivo es esta cabecera y los dos
+// arreglos en los offsets indicados, alineados a 16 bytes, con el mismo
+// layout que las estructuras en memoria (little endian, campos de 4 bytes)
+struct SceneFileHeader
+{
+	char magic[4];			// "ESCB"
+	uint32 version;
+	uint32 headerSize;
+	int32 bodyCount;
+	int32 fixtureCount;
+	int32 controlBody;
+	b2Vec2 gravity;
+	uint32 bodyOffset;		// Desde el inicio del archivo
+	uint32 fixtureOffset;
+	uint32 reserved[2];
+};
+
+// Cambiar cualquiera de estos tamaos cambia el formato: subir la version
+static_assert(sizeof(SceneFileHeader) == 48, "SceneFileHeader cambio de tamao");
+static_assert(sizeof(SceneBody) == 40, "SceneBody cambio de tamao");
+static_assert(sizeof(SceneFixture) == 96, "SceneFixture cambio de tamao");
+
+// Escena leida en el lugar desde un archivo mapeado: los punteros apuntan
+// dentro del mapeo y valen mientras el MappedFile siga abierto
+struct SceneView
+{
+	const SceneFileHeader* header;
+	const SceneBody* bodies;
+	const SceneFixture* fixtures;
+	int bodyCount;
+	int fixtureCount;
+};
+
+class SceneFile
+{
+public:
+	// Lee el archivo de texto. Si falla deja el motivo (con numero de linea) en error
+	static bool LoadText(const std::string& path, SceneData& data, std::string& error);
+
+	// Escribe la escena en texto (los materiales se nombran m0, m1, ...)
+	static bool SaveText(const std::string& path, const SceneData& data, std::string& error);
+
+	// Forma binaria: cabecera con version y offsets y los dos arreglos
+	static bool SaveBinary(const std::string& path, const SceneData& data, std::string& error);
+	static bool LoadBinary(const std::string& path, SceneData& data, std::string& error);
+
+	// Mapea el binario y valida la cabecera sin copiar ni parsear nada. El
+	// archivo tiene que quedar abierto mientras se use la vista
+	static bool MapBinary(const std::string& path, MappedFile& file, SceneView& view, std::string& error);
+
+	// Reconoce el formato por la firma del archivo
+	static bool Load(const std::string& path, SceneData& data, std::string& error);
+	static bool IsBinary(const std::string& path);
+
+	// Crean los cuerpos en el mundo y devuelven el de control (o nullptr).
+	// Si se pasa created, deja ahi el cuerpo creado para cada SceneBody
+	static b2Body* Build(const SceneData& data, b2World* phyWorld, std::vector<b2Body*>* created = nullptr);
+	static b2Body* Build(const SceneView& view, b2World* phyWorld, std::vector<b2Body*>* created = nullptr);
+	static b2Body* Build(const SceneBody* bodies, int bodyCount, const SceneFixture* fixtures, int32 controlBody, const b2Vec2& gravity, b2World* phyWorld, std::vector<b2Body*>* created = nullptr);
+
+	// Arma las definiciones de Box2D de un cuerpo y una fixture de la escena
+	static b2BodyDef MakeBodyDef(const SceneBody& body);
+	static b2Filter MakeFilter(const SceneBody& body);
+	static void CreateFixture(b2Body* body, const SceneBody& sceneBody, const SceneFixture& fixture);
+
+	// Crea un cuerpo con sus fixtures (fixtures es el arreglo completo)
+	static b2Body* CreateBody(b2World* phyWorld, const SceneBody& sceneBody, const SceneFixture* fixtures);
+};
@@ -0,0 +1,251 @@
+#include "SceneReloader.h"
+#include "CollisionLayers.h"
+#include <algorithm>
+#include <chrono>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// Constructor de la clase SceneReloader
+SceneReloader::SceneReloader(float pollInterval)
+{
+    this->pollInterval = pollInterval;
+    sincePoll = 0.0f;
+    lastStamp = -1;
+}
+
+// Fecha de modificacion combinada con el tamao: algunos sistemas de
+// archivos guardan la fecha en segundos y un guardado rapido no la cambia
+long long SceneReloader::GetStamp(const std::string& path)
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
+        return -1;
+    return (long long)info.st_mtime * 1000003LL + (long long)info.st_size;
+}
+
+void SceneReloader::Watch(const std::string& path, const SceneData& data, const std::vector<b2Body*>& created)
+{
+    this->path = path;
+    current = data;
+    bodies = created;
+    lastStamp = GetStamp(path);
+    sincePoll = 0.0f;
+}
+
+bool SceneReloader::Poll(float dt)
+{
+    if (path.empty())
+        return false;
+    sincePoll += dt;
+    if (sincePoll < pollInterval)
+        return false;
+    sincePoll = 0.0f;
+
+    long long stamp = GetStamp(path);
+    if (stamp < 0 || stamp == lastStamp)
+        return false;
+    lastStamp = stamp;
+    return true;
+}
+
+b2Body* SceneReloader::GetControlBody() const
+{
+    if (current.controlBody < 0 || current.controlBody >= (int)bodies.size())
+        return nullptr;
+    return bodies[current.controlBody];
+}
+
+bool SceneReloader::SameShape(const SceneFixture& a, const SceneFixture& b)
+{
+    if (a.shape != b.shape)
+        return false;
+    switch (a.shape)
+    {
+    case SceneShape_Box:
+        return a.width == b.width && a.height == b.height;
+    case SceneShape_Circle:
+        return a.radius == b.radius;
+    default:
+        if (a.vertexCount != b.vertexCount)
+            return false;
+        for (int v = 0; v < a.vertexCount; ++v)
+        {
+            if (a.vertices[v].x != b.vertices[v].x || a.vertices[v].y != b.vertices[v].y)
+                return false;
+        }
+        return true;
+    }
+}
+
+// Un cambio de tipo o de formas no se puede hacer en el lugar (Box2D no
+// cambia la forma de una fixture): el cuerpo se rehace
+bool SceneReloader::NeedsRebuild(const SceneData& next, int index) const
+{
+    const SceneBody& before = current.bodies[index];
+    const SceneBody& after = next.bodies[index];
+    if (before.type != after.type || before.fixtureCount != after.fixtureCount)
+        return true;
+    for (int f = 0; f < after.fixtureCount; ++f)
+    {
+        if (!SameShape(current.fixtures[before.firstFixture + f], next.fixtures[after.firstFixture + f]))
+            return true;
+    }
+    return false;
+}
+
+// Cambios que se aplican sobre el cuerpo existente. Se compara contra la
+// descripcion anterior y no contra el cuerpo vivo, asi lo que se movio
+// jugando no vuelve a su lugar si en el archivo no cambio. Devuelve
+// false si no habia nada que cambiar
+bool SceneReloader::Patch(const SceneData& next, int index)
+{
+    const SceneBody& before = current.bodies[index];
+    const SceneBody& after = next.bodies[index];
+    b2Body* body = bodies[index];
+    bool changed = false;
+
+    if (before.position.x != after.position.x || before.position.y != after.position.y || before.angle != after.angle)
+    {
+        body->SetTransform(after.position, after.angle);
+        changed = true;
+    }
+    if (before.linearVelocity.x != after.linearVelocity.x || before.linearVelocity.y != after.linearVelocity.y
+        || before.angularVelocity != after.angularVelocity)
+    {
+        body->SetLinearVelocity(after.linearVelocity);
+        body->SetAngularVelocity(after.angularVelocity);
+        changed = true;
+    }
+
+    // Box2D guarda las fixtures al reves del orden de creacion
+    fixtureScratch.clear();
+    for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        fixtureScratch.push_back(fixture);
+    std::reverse(fixtureScratch.begin(), fixtureScratch.end());
+
+    bool layerChanged = before.layer != after.layer;
+    b2Filter filter = SceneFile::MakeFilter(after);
+    bool massChanged = false;
+    bool frictionChanged = false;
+    bool restitutionChanged = false;
+    for (int f = 0; f < after.fixtureCount && f < (int)fixtureScratch.size(); ++f)
+    {
+        const SceneFixture& oldFixture = current.fixtures[before.firstFixture + f];
+        const SceneFixture& newFixture = next.fixtures[after.firstFixture + f];
+        b2Fixture* fixture = fixtureScratch[f];
+        if (oldFixture.density != newFixture.density)
+        {
+            fixture->SetDensity(newFixture.density);
+            massChanged = true;
+        }
+        if (oldFixture.friction != newFixture.friction)
+        {
+            fixture->SetFriction(newFixture.friction);
+            frictionChanged = true;
+        }
+        if (oldFixture.restitution != newFixture.restitution)
+        {
+            fixture->SetRestitution(newFixture.restitution);
+            restitutionChanged = true;
+        }
+        if (layerChanged)
+            fixture->SetFilterData(filter);
+    }
+
+    if (massChanged)
+        body->ResetMassData();
+
+    // Los contactos ya creados guardan la friccion y la restitucion
+    // mezcladas al crearse: se recalculan para que el cambio se note ya
+    if (frictionChanged || restitutionChanged)
+    {
+        for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next)
+        {
+            if (frictionChanged)
+                edge->contact->ResetFriction();
+            if (restitutionChanged)
+                edge->contact->ResetRestitution();
+        }
+    }
+
+    changed = changed || layerChanged || massChanged || frictionChanged || restitutionChanged;
+    if (changed)
+        body->SetAwake(true);
+    return changed;
+}
+
+void SceneReloader::Apply(const SceneData& next, b2World* phyWorld, SceneReloadStats& stats)
+{
+    auto start = std::chrono::steady_clock::now();
+    stats.created = 0;
+    stats.destroyed = 0;
+    stats.rebuilt = 0;
+    stats.patched = 0;
+    stats.unchanged = 0;
+
+    if (next.gravity.x != current.gravity.x || next.gravity.y != current.gravity.y)
+        phyWorld->SetGravity(next.gravity);
+
+    // Los cuerpos se emparejan por posicion en el archivo
+    int oldCount = (int)current.bodies.size();
+    int newCount = (int)next.bodies.size();
+    for (int i = newCount; i < oldCount; ++i)
+    {
+        phyWorld->DestroyBody(bodies[i]);
+        stats.destroyed++;
+    }
+    bodies.resize(newCount);
+
+    for (int i = 0; i < newCount; ++i)
+    {
+        if (i >= oldCount)
+        {
+            bodies[i] = SceneFile::CreateBody(phyWorld, next.bodies[i], next.fixtures.data());
+            stats.created++;
+        }
+        else if (NeedsRebuild(next, i))
+        {
+            phyWorld->DestroyBody(bodies[i]);
+            bodies[i] = SceneFile::CreateBody(phyWorld, next.bodies[i], next.fixtures.data());
+            stats.rebuilt++;
+        }
+        else if (Patch(next, i))
+            stats.patched++;
+        else
+            stats.unchanged++;
+    }
+
+    // Como en SceneFile::Build, el cuerpo de control sin capa es del jugador.
+    // Si el control pas a otro cuerpo, el anterior vuelve a la capa de su tipo
+    int oldControl = current.controlBody;
+    if (oldControl != next.controlBody && oldControl >= 0 && oldControl < newCount && next.bodies[oldControl].layer < 0)
+        CollisionLayers::Apply(bodies[oldControl], CollisionLayers::DefaultLayer((b2BodyType)next.bodies[oldControl].type));
+    if (next.controlBody >= 0 && next.controlBody < newCount && next.bodies[next.controlBody].layer < 0)
+        CollisionLayers::Apply(bodies[next.controlBody], Layer_Player);
+
+    current = next;
+    stats.applyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool SceneReloader::Reload(b2World* phyWorld, SceneReloadStats& stats, std::string& error)
+{
+    if (phyWorld->IsLocked())
+    {
+        error = "el mundo esta en medio de un paso";
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SceneData next;
+    if (!SceneFile::Load(path, next, error))
+        return false;
+    if (next.controlBody < 0 || next.controlBody >= (int)next.bodies.size())
+    {
+        error = path + " no marca un cuerpo de control";
+        return false;
+    }
+    stats.readMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    Apply(next, phyWorld, stats);
+    return true;
+}
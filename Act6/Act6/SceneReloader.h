@@ -0,0 +1,68 @@
+//-----------------------------------------------------
+//Recarga en caliente del archivo de escena. Se consulta
+//la fecha del archivo cada tanto y, si cambio, la nueva
+//descripcion se compara cuerpo por cuerpo con la que
+//se armo: solo se crean, destruyen o modifican los
+//cuerpos y fixtures que cambiaron, sin tocar el resto
+//del mundo ni la ventana
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <string>
+#include <vector>
+#include "SceneFile.h"
+
+// Resultado de una recarga
+struct SceneReloadStats
+{
+	int created;		// Cuerpos nuevos al final de la escena
+	int destroyed;		// Cuerpos que ya no estan
+	int rebuilt;		// Cambio el tipo o la forma: se destruyen y se crean de nuevo
+	int patched;		// Cambio la posicion, la capa o el material
+	int unchanged;
+	double readMs;		// Lectura del archivo
+	double applyMs;		// Cambios en el mundo
+};
+
+class SceneReloader
+{
+private:
+	std::string path;
+	long long lastStamp;		// Fecha y tamao del archivo
+	float pollInterval;
+	float sincePoll;
+
+	// Escena armada y el cuerpo vivo de cada SceneBody (mismo indice)
+	SceneData current;
+	std::vector<b2Body*> bodies;
+	std::vector<b2Fixture*> fixtureScratch;
+
+	static long long GetStamp(const std::string& path);
+	static bool SameShape(const SceneFixture& a, const SceneFixture& b);
+	bool NeedsRebuild(const SceneData& next, int index) const;
+	bool Patch(const SceneData& next, int index);
+
+public:
+	// pollInterval: segundos entre consultas de la fecha del archivo
+	SceneReloader(float pollInterval = 0.5f);
+
+	// Empieza a vigilar el archivo. data es la escena ya armada y
+	// created[i] el cuerpo creado para data.bodies[i]
+	void Watch(const std::string& path, const SceneData& data, const std::vector<b2Body*>& created);
+	bool IsWatching() const { return !path.empty(); }
+
+	// Se llama una vez por frame. Devuelve true cuando el archivo cambio
+	bool Poll(float dt);
+
+	// Relee el archivo y aplica las diferencias. Si no se puede leer o no
+	// marca un cuerpo de control deja el mundo como estaba
+	bool Reload(b2World* phyWorld, SceneReloadStats& stats, std::string& error);
+
+	// Aplica una escena nueva al mundo (lo que hace Reload despues de leer)
+	void Apply(const SceneData& next, b2World* phyWorld, SceneReloadStats& stats);
+
+	// Cuerpo de control de la escena actual
+	b2Body* GetControlBody() const;
+	const std::string& GetPath() const { return path; }
+};
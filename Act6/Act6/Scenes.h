@@ -0,0 +1,215 @@
+#pragma once
+#include <Box2D/Box2D.h>
+#include <cstring>
+#include "Box2DHelper.h"
+
+//-------------------------------------------------------------
+// Identificadores de las escenas de cada ejercicio
+//-------------------------------------------------------------
+enum SceneId
+{
+	Scene_Ejercicio1 = 0,
+	Scene_Ejercicio2,
+	Scene_Ejercicio3,
+	Scene_Ejercicio4,
+	Scene_Act5,
+	Scene_Act6,
+	Scene_Count
+};
+
+//-------------------------------------------------------------
+// Clase utilitaria que arma en un b2World las mismas escenas que
+// construye el InitPhysics() de cada ejercicio, sin ventana.
+// La usan las herramientas de linea de comandos (auditoria,
+// benchmarks, barridos) para trabajar sobre las escenas reales.
+//-------------------------------------------------------------
+class Scenes
+{
+public:
+	//-------------------------------------------------------------
+	// Nombre corto de la escena (el que se usa en la linea de comandos)
+	//-------------------------------------------------------------
+	static const char* GetName(SceneId id)
+	{
+		static const char* names[Scene_Count] = { "ejercicio1", "ejercicio2", "ejercicio3", "ejercicio4", "act5", "act6" };
+		return (id >= 0 && id < Scene_Count) ? names[id] : "desconocida";
+	}
+
+	//-------------------------------------------------------------
+	// Busca una escena por nombre, devuelve false si no existe
+	//-------------------------------------------------------------
+	static bool FromName(const char* name, SceneId& id)
+	{
+		for (int i = 0; i < Scene_Count; ++i)
+		{
+			if (std::strcmp(name, GetName((SceneId)i)) == 0)
+			{
+				id = (SceneId)i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//-------------------------------------------------------------
+	// Arma la escena pedida y devuelve su cuerpo de control
+	//-------------------------------------------------------------
+	static b2Body* Build(SceneId id, b2World* phyWorld)
+	{
+		switch (id)
+		{
+		case Scene_Ejercicio1: return BuildEjercicio1(phyWorld);
+		case Scene_Ejercicio2: return BuildEjercicio2(phyWorld);
+		case Scene_Ejercicio3: return BuildEjercicio3(phyWorld);
+		case Scene_Ejercicio4: return BuildEjercicio4(phyWorld);
+		case Scene_Act5: return BuildAct5(phyWorld);
+		case Scene_Act6: return BuildAct6(phyWorld);
+		default: return nullptr;
+		}
+	}
+
+	//-------------------------------------------------------------
+	// Ejercicio 1: bloque que cae sobre el suelo
+	//-------------------------------------------------------------
+	static b2Body* BuildEjercicio1(b2World* phyWorld)
+	{
+		b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
+		groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
+
+		b2Body* fallingBlock = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 10, 10, 1.0f, 0.5f, 0.3f);
+		fallingBlock->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+		CollisionLayers::Apply(fallingBlock, Layer_Player);
+
+		return fallingBlock;
+	}
+
+	//-------------------------------------------------------------
+	// Ejercicio 2: pelota en una caja con paredes de restitucion 3
+	//-------------------------------------------------------------
+	static b2Body* BuildEjercicio2(b2World* phyWorld)
+	{
+		BuildBouncyBox(phyWorld, 3.0f);
+
+		b2Body* controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 0.1f);
+		controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+		CollisionLayers::Apply(controlBody, Layer_Player);
+
+		return controlBody;
+	}
+
+	//-------------------------------------------------------------
+	// Ejercicio 3: el ejercicio 2 mas cuatro obstaculos de restitucion 2
+	//-------------------------------------------------------------
+	static b2Body* BuildEjercicio3(b2World* phyWorld)
+	{
+		BuildBouncyBox(phyWorld, 3.0f);
+
+		const b2Vec2 obstacles[4] = { b2Vec2(45.0f, 60.0f), b2Vec2(65.0f, 30.0f), b2Vec2(15.0f, 20.0f), b2Vec2(80.0f, 80.0f) };
+		for (int i = 0; i < 4; ++i)
+		{
+			b2Body* obstacle = Box2DHelper::CreateRectangularStaticBody(phyWorld, 5, 5);
+			obstacle->SetTransform(obstacles[i], 0.0f);
+			obstacle->GetFixtureList()->SetRestitution(2.0f);
+		}
+
+		b2Body* controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 0.1f);
+		controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+		CollisionLayers::Apply(controlBody, Layer_Player);
+
+		return controlBody;
+	}
+
+	//-------------------------------------------------------------
+	// Ejercicio 4: circulo controlado con el teclado sobre el suelo
+	//-------------------------------------------------------------
+	static b2Body* BuildEjercicio4(b2World* phyWorld)
+	{
+		BuildFloorAndWalls(phyWorld, 0.5f, 1.0f);
+
+		b2Body* controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 0.1f);
+		controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+		CollisionLayers::Apply(controlBody, Layer_Player);
+
+		return controlBody;
+	}
+
+	//-------------------------------------------------------------
+	// Act5: bloque sobre un plano inclinado a 45 grados
+	//-------------------------------------------------------------
+	static b2Body* BuildAct5(b2World* phyWorld)
+	{
+		float alphaAng = 45.0f * (b2_pi / 180.0f);
+
+		b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 120, 10);
+		groundBody->SetTransform(b2Vec2(50.0f, 60.0f), alphaAng);
+		groundBody->GetFixtureList()->SetFriction(0.3f);
+
+		b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+		leftWallBody->GetFixtureList()->SetRestitution(1.0f);
+
+		b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
+		rightWallBody->GetFixtureList()->SetRestitution(1.0f);
+
+		b2Body* controlBody = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 10, 10, 1.0f, 0.5, 0.1f);
+		controlBody->SetTransform(b2Vec2(25.0f, 20.0f), alphaAng);
+		CollisionLayers::Apply(controlBody, Layer_Player);
+
+		return controlBody;
+	}
+
+	//-------------------------------------------------------------
+	// Act6: caon cinematico entre dos paredes
+	//-------------------------------------------------------------
+	static b2Body* BuildAct6(b2World* phyWorld)
+	{
+		BuildFloorAndWalls(phyWorld, 0.5f, 1.0f);
+
+		b2Body* controlBody = Box2DHelper::CreateRectangularKinematicBody(phyWorld, 15, 10);
+		controlBody->SetTransform(b2Vec2(10.0f, 50.0f), 0.0f);
+
+		return controlBody;
+	}
+
+private:
+	//-------------------------------------------------------------
+	// Suelo con friccion y paredes con restitucion (Ejercicio 4 y Act6)
+	//-------------------------------------------------------------
+	static void BuildFloorAndWalls(b2World* phyWorld, float groundFriction, float wallRestitution)
+	{
+		b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
+		groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
+		groundBody->GetFixtureList()->SetFriction(groundFriction);
+
+		b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+		leftWallBody->GetFixtureList()->SetRestitution(wallRestitution);
+
+		b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
+		rightWallBody->GetFixtureList()->SetRestitution(wallRestitution);
+	}
+
+	//-------------------------------------------------------------
+	// Suelo, paredes y techo con la misma restitucion (Ejercicio 2 y 3)
+	//-------------------------------------------------------------
+	static void BuildBouncyBox(b2World* phyWorld, float restitution)
+	{
+		b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
+		groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
+		groundBody->GetFixtureList()->SetRestitution(restitution);
+
+		b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+		leftWallBody->GetFixtureList()->SetRestitution(restitution);
+
+		b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
+		rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
+		rightWallBody->GetFixtureList()->SetRestitution(restitution);
+
+		b2Body* ceilingBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
+		ceilingBody->SetTransform(b2Vec2(50.0f, 0.0f), 0.0f);
+		ceilingBody->GetFixtureList()->SetRestitution(restitution);
+	}
+};
@@ -0,0 +1,79 @@
+#include "SpatialQuery.h"
+
+// Constructor de la clase SpatialQuery
+SpatialQuery::SpatialQuery(b2World* world)
+{
+    phyWorld = world;
+    fixtures.reserve(1024);
+    offsets.reserve(256);
+    hits.reserve(256);
+}
+
+int SpatialQuery::QueryAABBs(const b2AABB* boxes, int count, uint16 maskBits)
+{
+    fixtures.clear();
+    offsets.resize(count + 1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        offsets[i] = (int)fixtures.size();
+        ForEachAABB(phyWorld, boxes[i], [this, maskBits](b2Fixture* fixture) {
+            if (Accepts(fixture, maskBits))
+                fixtures.push_back(fixture);
+            return true;
+        });
+    }
+    offsets[count] = (int)fixtures.size();
+    return offsets[count];
+}
+
+int SpatialQuery::QueryPoints(const b2Vec2* points, int count, uint16 maskBits)
+{
+    fixtures.clear();
+    offsets.resize(count + 1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        offsets[i] = (int)fixtures.size();
+
+        // Caja minima alrededor del punto y despues la prueba exacta
+        const b2Vec2& point = points[i];
+        b2AABB box;
+        box.lowerBound.Set(point.x - 0.001f, point.y - 0.001f);
+        box.upperBound.Set(point.x + 0.001f, point.y + 0.001f);
+        ForEachAABB(phyWorld, box, [this, maskBits, &point](b2Fixture* fixture) {
+            if (Accepts(fixture, maskBits) && fixture->TestPoint(point))
+                fixtures.push_back(fixture);
+            return true;
+        });
+    }
+    offsets[count] = (int)fixtures.size();
+    return offsets[count];
+}
+
+int SpatialQuery::RayCastClosest(const b2Vec2* from, const b2Vec2* to, int count, uint16 maskBits)
+{
+    hits.resize(count);
+    int hitCount = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        RayHit& hit = hits[i];
+        hit.fixture = nullptr;
+        hit.fraction = 1.0f;
+
+        // Devolver la fraccion recorta el rayo: al final queda el mas cercano
+        ForEachRay(phyWorld, from[i], to[i], [&hit, maskBits](b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) {
+            if (!Accepts(fixture, maskBits))
+                return -1.0f;
+            hit.fixture = fixture;
+            hit.point = point;
+            hit.normal = normal;
+            hit.fraction = fraction;
+            return fraction;
+        });
+        if (hit.fixture)
+            hitCount++;
+    }
+    return hitCount;
+}
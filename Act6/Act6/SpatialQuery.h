@@ -0,0 +1,95 @@
+//-----------------------------------------------------
+//Consultas espaciales en lote sobre b2World: cajas,
+//puntos y rayos. Los resultados quedan en arreglos
+//planos que se reusan entre llamadas (una lista de
+//fixtures y un offset por consulta), y los callbacks
+//de Box2D son plantillas en la pila, sin new por
+//consulta
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Resultado de un rayo (fixture nulo si no choco con nada)
+struct RayHit
+{
+	b2Fixture* fixture;
+	b2Vec2 point;
+	b2Vec2 normal;
+	float fraction;
+};
+
+class SpatialQuery
+{
+private:
+	// Adaptadores de b2QueryCallback / b2RayCastCallback a cualquier
+	// funcion o lambda. Viven en la pila del llamador
+	template <typename F>
+	struct AABBCallback : public b2QueryCallback
+	{
+		F& f;
+		AABBCallback(F& func) : f(func) {}
+		bool ReportFixture(b2Fixture* fixture) override { return f(fixture); }
+	};
+
+	template <typename F>
+	struct RayCallback : public b2RayCastCallback
+	{
+		F& f;
+		RayCallback(F& func) : f(func) {}
+		float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+		{
+			return f(fixture, point, normal, fraction);
+		}
+	};
+
+	b2World* phyWorld;
+	std::vector<b2Fixture*> fixtures;	// Resultados de todas las consultas, uno detras de otro
+	std::vector<int> offsets;			// Consulta i: fixtures[offsets[i]] .. fixtures[offsets[i + 1] - 1]
+	std::vector<RayHit> hits;			// Un resultado por rayo
+
+	static bool Accepts(const b2Fixture* fixture, uint16 maskBits)
+	{
+		return (fixture->GetFilterData().categoryBits & maskBits) != 0;
+	}
+
+public:
+	SpatialQuery(b2World* world);
+
+	// Llama a f(b2Fixture*) por cada fixture cuyo AABB toca la caja. Si f
+	// devuelve false la busqueda termina
+	template <typename F>
+	static void ForEachAABB(b2World* world, const b2AABB& box, F f)
+	{
+		AABBCallback<F> callback(f);
+		world->QueryAABB(&callback, box);
+	}
+
+	// Llama a f(fixture, point, normal, fraction) por cada fixture que
+	// cruza el rayo. El valor devuelto recorta el rayo como en b2RayCastCallback
+	template <typename F>
+	static void ForEachRay(b2World* world, const b2Vec2& from, const b2Vec2& to, F f)
+	{
+		RayCallback<F> callback(f);
+		world->RayCast(&callback, from, to);
+	}
+
+	// Fixtures cuyo AABB toca cada caja (fase ancha). maskBits filtra por
+	// categoria de colision. Devuelve el total de resultados
+	int QueryAABBs(const b2AABB* boxes, int count, uint16 maskBits = 0xFFFF);
+
+	// Fixtures que contienen cada punto (prueba exacta con la forma)
+	int QueryPoints(const b2Vec2* points, int count, uint16 maskBits = 0xFFFF);
+
+	// Primer impacto de cada rayo from[i] -> to[i]. Devuelve cuantos chocaron
+	int RayCastClosest(const b2Vec2* from, const b2Vec2* to, int count, uint16 maskBits = 0xFFFF);
+
+	// Resultados de la ultima consulta de cajas o puntos
+	int GetResultCount(int query) const { return offsets[query + 1] - offsets[query]; }
+	b2Fixture* const* GetResults(int query) const { return fixtures.data() + offsets[query]; }
+	int GetTotalCount() const { return (int)fixtures.size(); }
+
+	// Resultado de la ultima consulta de rayos
+	const RayHit& GetHit(int ray) const { return hits[ray]; }
+};
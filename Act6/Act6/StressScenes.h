@@ -0,0 +1,335 @@
+#pragma once
+#include <Box2D/Box2D.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include "Box2DHelper.h"
+
+//-------------------------------------------------------------
+// Tipos de escena de estres, cada uno inspirado en un ejercicio
+//-------------------------------------------------------------
+enum StressKind
+{
+	Stress_Pyramid = 0,		// Piramides de cajas apiladas
+	Stress_ObstacleGrid,	// Pelotas cayendo entre obstaculos con rebote (Ejercicio 3)
+	Stress_BallPit,			// Pileta de pelotas de tamaos distintos
+	Stress_Ramps,			// Cajas en planos inclinados con friccion (Act5)
+	Stress_BulletStorm,		// Balas rapidas con CCD contra blancos fijos (Act6)
+	Stress_Count
+};
+
+//-------------------------------------------------------------
+// Parametros de la escena. bodyCount es aproximado (se completan
+// filas y piramides) y va de 100 a 1000000
+//-------------------------------------------------------------
+struct StressParams
+{
+	StressKind kind;
+	int bodyCount;			// 0: no hay escena de estres
+	uint32 seed;
+
+	StressParams() : kind(Stress_Pyramid), bodyCount(0), seed(1) {}
+	StressParams(StressKind kind, int bodyCount, uint32 seed) : kind(kind), bodyCount(bodyCount), seed(seed) {}
+};
+
+//-------------------------------------------------------------
+// Lo que quedo armado
+//-------------------------------------------------------------
+struct StressSceneInfo
+{
+	b2Body* controlBody;	// Cuerpo cinematico a la izquierda de la escena
+	b2AABB bounds;			// Caja que contiene toda la escena
+	int dynamicCount;
+	int staticCount;
+};
+
+//-------------------------------------------------------------
+// Generador de escenas grandes con las formas de Box2DHelper
+// para medir como escala el motor. La misma semilla arma la
+// misma escena en cualquier compilador: los numeros salen de
+// mt19937 (que el estandar fija) y no de las distribuciones
+// de la biblioteca, que cambian entre implementaciones
+//-------------------------------------------------------------
+class StressScenes
+{
+public:
+	static const int MinBodies = 100;
+	static const int MaxBodies = 1000000;
+
+	//-------------------------------------------------------------
+	// Nombre corto del tipo (el que se usa en la linea de comandos)
+	//-------------------------------------------------------------
+	static const char* GetName(StressKind kind)
+	{
+		static const char* names[Stress_Count] = { "piramide", "obstaculos", "pileta", "rampas", "balas" };
+		return (kind >= 0 && kind < Stress_Count) ? names[kind] : "desconocida";
+	}
+
+	//-------------------------------------------------------------
+	// Busca un tipo por nombre, devuelve false si no existe
+	//-------------------------------------------------------------
+	static bool FromName(const char* name, StressKind& kind)
+	{
+		for (int i = 0; i < Stress_Count; ++i)
+		{
+			if (std::strcmp(name, GetName((StressKind)i)) == 0)
+			{
+				kind = (StressKind)i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//-------------------------------------------------------------
+	// Arma la escena pedida en el mundo
+	//-------------------------------------------------------------
+	static StressSceneInfo Build(b2World* phyWorld, const StressParams& params)
+	{
+		StressSceneInfo info;
+		info.dynamicCount = 0;
+		info.staticCount = 0;
+		info.bounds.lowerBound.Set(b2_maxFloat, b2_maxFloat);
+		info.bounds.upperBound.Set(-b2_maxFloat, -b2_maxFloat);
+
+		int count = b2Clamp(params.bodyCount, MinBodies, MaxBodies);
+		std::mt19937 rng(params.seed);
+		switch (params.kind)
+		{
+		case Stress_Pyramid: BuildPyramids(phyWorld, count, info); break;
+		case Stress_ObstacleGrid: BuildObstacleGrid(phyWorld, count, rng, info); break;
+		case Stress_BallPit: BuildBallPit(phyWorld, count, rng, info); break;
+		case Stress_Ramps: BuildRamps(phyWorld, count, rng, info); break;
+		default: BuildBulletStorm(phyWorld, count, rng, info); break;
+		}
+
+		// Control como el caon de Act6, afuera de la escena
+		info.controlBody = Box2DHelper::CreateRectangularKinematicBody(phyWorld, 15, 10);
+		info.controlBody->SetTransform(b2Vec2(info.bounds.lowerBound.x - 20.0f, info.bounds.upperBound.y - 20.0f), 0.0f);
+		Grow(info, info.controlBody->GetPosition(), 10.0f);
+		return info;
+	}
+
+private:
+	//-------------------------------------------------------------
+	// Numero en [lo, hi) a partir de los 32 bits de mt19937
+	//-------------------------------------------------------------
+	static float Uniform(std::mt19937& rng, float lo, float hi)
+	{
+		return lo + (hi - lo) * (float)(rng() / 4294967296.0);
+	}
+
+	static void Grow(StressSceneInfo& info, const b2Vec2& center, float extent)
+	{
+		Grow(info, center, extent, extent);
+	}
+
+	static void Grow(StressSceneInfo& info, const b2Vec2& center, float halfWidth, float halfHeight)
+	{
+		info.bounds.lowerBound = b2Min(info.bounds.lowerBound, b2Vec2(center.x - halfWidth, center.y - halfHeight));
+		info.bounds.upperBound = b2Max(info.bounds.upperBound, b2Vec2(center.x + halfWidth, center.y + halfHeight));
+	}
+
+	static b2Body* AddStatic(b2World* phyWorld, StressSceneInfo& info, float width, float height, const b2Vec2& position, float angle)
+	{
+		b2Body* body = Box2DHelper::CreateRectangularStaticBody(phyWorld, width, height);
+		body->SetTransform(position, angle);
+		if (angle == 0.0f)
+			Grow(info, position, 0.5f * width, 0.5f * height);
+		else
+			Grow(info, position, 0.5f * b2Vec2(width, height).Length());
+		info.staticCount++;
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Pileta: suelo y paredes alrededor de width x height metros; el
+	// suelo queda con la cara de arriba en y = height
+	//-------------------------------------------------------------
+	static void BuildContainer(b2World* phyWorld, StressSceneInfo& info, float width, float height, float restitution)
+	{
+		b2Body* ground = AddStatic(phyWorld, info, width + 20.0f, 10.0f, b2Vec2(width / 2.0f, height + 5.0f), 0.0f);
+		b2Body* left = AddStatic(phyWorld, info, 10.0f, height, b2Vec2(-5.0f, height / 2.0f), 0.0f);
+		b2Body* right = AddStatic(phyWorld, info, 10.0f, height, b2Vec2(width + 5.0f, height / 2.0f), 0.0f);
+		ground->GetFixtureList()->SetRestitution(restitution);
+		left->GetFixtureList()->SetRestitution(restitution);
+		right->GetFixtureList()->SetRestitution(restitution);
+	}
+
+	//-------------------------------------------------------------
+	// Piramides de hasta 40 cajas de base sobre estantes en grilla:
+	// mas altas se desarman solas y miden otra cosa
+	//-------------------------------------------------------------
+	static void BuildPyramids(b2World* phyWorld, int count, StressSceneInfo& info)
+	{
+		const int baseRows = 40;
+		const int perPyramid = baseRows * (baseRows + 1) / 2;
+		const float cell = 45.0f;
+		int pyramids = (count + perPyramid - 1) / perPyramid;
+		int columns = 1;
+		while (columns * columns < pyramids)
+			columns++;
+
+		int placed = 0;
+		for (int p = 0; p < pyramids; ++p)
+		{
+			int cx = p % columns;
+			int cy = p / columns;
+			float shelfTop = (cy + 1) * cell;
+			if (cx == 0)
+				AddStatic(phyWorld, info, columns * cell, 2.0f, b2Vec2(columns * cell / 2.0f, shelfTop + 1.0f), 0.0f);
+
+			for (int row = 0; row < baseRows && placed < count; ++row)
+			{
+				for (int k = 0; k < baseRows - row && placed < count; ++k)
+				{
+					b2Body* box = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 1.0f, 1.0f, 1.0f, 0.6f, 0.0f);
+					b2Vec2 position(cx * cell + 2.5f + row * 0.5f + k * 1.0f, shelfTop - 0.5f - row * 1.0f);
+					box->SetTransform(position, 0.0f);
+					Grow(info, position, 0.5f);
+					info.dynamicCount++;
+					placed++;
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------
+	// Un cuarto de los cuerpos son obstaculos fijos de restitucion 2
+	// en tresbolillo y el resto pelotas que caen entre ellos
+	//-------------------------------------------------------------
+	static void BuildObstacleGrid(b2World* phyWorld, int count, std::mt19937& rng, StressSceneInfo& info)
+	{
+		int obstacles = count / 4;
+		int balls = count - obstacles;
+		int columns = 1;
+		while (columns * columns < obstacles)
+			columns++;
+		int rows = (obstacles + columns - 1) / columns;
+
+		const float spacing = 4.0f;
+		float width = columns * spacing + spacing;
+		int ballColumns = (int)(width / 1.5f) - 1;
+		int ballRows = (balls + ballColumns - 1) / ballColumns;
+		float ballsHeight = ballRows * 1.5f + 2.0f;
+		float height = ballsHeight + rows * spacing + spacing;
+		BuildContainer(phyWorld, info, width, height, 3.0f);
+
+		for (int i = 0; i < obstacles; ++i)
+		{
+			int row = i / columns;
+			int column = i % columns;
+			float x = spacing + column * spacing + (row % 2 ? spacing / 2.0f : 0.0f);
+			b2Body* obstacle = AddStatic(phyWorld, info, 1.0f, 1.0f, b2Vec2(x, ballsHeight + spacing + row * spacing), Uniform(rng, 0.0f, b2_pi));
+			obstacle->GetFixtureList()->SetRestitution(2.0f);
+		}
+
+		for (int i = 0; i < balls; ++i)
+		{
+			b2Body* ball = Box2DHelper::CreateCircularDynamicBody(phyWorld, 0.5f, 1.0f, 0.5f, 0.1f);
+			b2Vec2 position(1.5f + (i % ballColumns) * 1.5f + Uniform(rng, -0.2f, 0.2f), 1.0f + (i / ballColumns) * 1.5f);
+			ball->SetTransform(position, 0.0f);
+			Grow(info, position, 0.5f);
+			info.dynamicCount++;
+		}
+	}
+
+	//-------------------------------------------------------------
+	// Pelotas de radio 0.3 a 0.6 en una grilla con ruido, apretadas en
+	// una pileta cuadrada
+	//-------------------------------------------------------------
+	static void BuildBallPit(b2World* phyWorld, int count, std::mt19937& rng, StressSceneInfo& info)
+	{
+		const float spacing = 1.3f;
+		int columns = 1;
+		while (columns * columns < count)
+			columns++;
+		float width = columns * spacing + spacing;
+		float height = ((count + columns - 1) / columns) * spacing + spacing;
+		BuildContainer(phyWorld, info, width, height, 0.1f);
+
+		for (int i = 0; i < count; ++i)
+		{
+			float radius = Uniform(rng, 0.3f, 0.6f);
+			float jitter = (spacing / 2.0f - radius) * 0.9f;
+			b2Body* ball = Box2DHelper::CreateCircularDynamicBody(phyWorld, radius, 1.0f, 0.4f, 0.2f);
+			b2Vec2 position(spacing + (i % columns) * spacing + Uniform(rng, -jitter, jitter), spacing / 2.0f + (i / columns) * spacing);
+			ball->SetTransform(position, 0.0f);
+			Grow(info, position, radius);
+			info.dynamicCount++;
+		}
+	}
+
+	//-------------------------------------------------------------
+	// Rampas de 20 m con friccion 0.3 e inclinacion de 20 a 45 grados,
+	// alternando el sentido en cada fila, con 20 cajas apoyadas
+	//-------------------------------------------------------------
+	static void BuildRamps(b2World* phyWorld, int count, std::mt19937& rng, StressSceneInfo& info)
+	{
+		const int boxesPerRamp = 20;
+		const float cellWidth = 30.0f;
+		const float cellHeight = 20.0f;
+		int ramps = b2Max(1, count / (boxesPerRamp + 1));
+		int columns = 1;
+		while (columns * columns < ramps)
+			columns++;
+
+		int placed = ramps;
+		for (int r = 0; r < ramps; ++r)
+		{
+			int cx = r % columns;
+			int cy = r / columns;
+			float angle = Uniform(rng, 20.0f, 45.0f) * (b2_pi / 180.0f) * (cy % 2 ? -1.0f : 1.0f);
+			b2Vec2 center(cx * cellWidth + cellWidth / 2.0f, cy * cellHeight + cellHeight / 2.0f);
+			b2Body* ramp = AddStatic(phyWorld, info, 20.0f, 1.0f, center, angle);
+			ramp->GetFixtureList()->SetFriction(0.3f);
+
+			// Sobre la cara de arriba (y crece hacia abajo)
+			b2Vec2 along(std::cos(angle), std::sin(angle));
+			b2Vec2 up(std::sin(angle), -std::cos(angle));
+			int boxes = b2Min(boxesPerRamp, count - placed);
+			for (int k = 0; k < boxes; ++k)
+			{
+				b2Body* box = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 0.8f, 0.8f, 1.0f, 0.5f, 0.1f);
+				b2Vec2 position = center + (-9.0f + k * 0.9f) * along + 1.0f * up;
+				box->SetTransform(position, angle);
+				Grow(info, position, 0.5f);
+				info.dynamicCount++;
+			}
+			placed += b2Max(boxes, 0);
+		}
+	}
+
+	//-------------------------------------------------------------
+	// Una decima parte son blancos fijos y el resto balas chicas con
+	// CCD a 30-60 m/s en direcciones al azar, dentro de una pileta
+	//-------------------------------------------------------------
+	static void BuildBulletStorm(b2World* phyWorld, int count, std::mt19937& rng, StressSceneInfo& info)
+	{
+		int targets = count / 10;
+		int bullets = count - targets;
+		float size = 3.0f;
+		while (size * size < count * 9.0f)
+			size *= 1.25f;
+		BuildContainer(phyWorld, info, size, size, 1.0f);
+
+		for (int i = 0; i < targets; ++i)
+		{
+			b2Vec2 position(Uniform(rng, 2.0f, size - 2.0f), Uniform(rng, 2.0f, size - 2.0f));
+			AddStatic(phyWorld, info, 2.0f, 2.0f, position, Uniform(rng, 0.0f, b2_pi));
+		}
+
+		for (int i = 0; i < bullets; ++i)
+		{
+			b2Body* bullet = Box2DHelper::CreateCircularDynamicBody(phyWorld, 0.2f, 5.0f, 0.1f, 0.5f);
+			bullet->SetBullet(true);
+			b2Vec2 position(Uniform(rng, 1.0f, size - 1.0f), Uniform(rng, 1.0f, size - 1.0f));
+			float direction = Uniform(rng, 0.0f, 2.0f * b2_pi);
+			float speed = Uniform(rng, 30.0f, 60.0f);
+			bullet->SetTransform(position, 0.0f);
+			bullet->SetLinearVelocity(b2Vec2(speed * std::cos(direction), speed * std::sin(direction)));
+			Grow(info, position, 0.2f);
+			info.dynamicCount++;
+		}
+	}
+};
@@ -0,0 +1,104 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+// Constructor de la clase ThreadPool
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount < 0)
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+    job = nullptr;
+    jobCount = 0;
+    chunkSize = 1;
+    chunkCount = 0;
+    nextChunk = 0;
+    generation = 0;
+    busyWorkers = 0;
+    quit = false;
+
+    for (int i = 0; i < threadCount; ++i)
+        workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+}
+
+// Destructor: despierta a los hilos para que salgan y los espera
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// Toma bloques del lote actual hasta que no queden
+void ThreadPool::RunChunks()
+{
+    for (;;)
+    {
+        int chunk = nextChunk.fetch_add(1);
+        if (chunk >= chunkCount)
+            return;
+        int begin = chunk * chunkSize;
+        int end = std::min(begin + chunkSize, jobCount);
+        (*job)(begin, end);
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    unsigned int seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return quit || generation != seen; });
+            if (quit)
+                return;
+            seen = generation;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        done.notify_one();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, int minChunk, const std::function<void(int, int)>& func)
+{
+    if (count <= 0)
+        return;
+
+    // Lote chico o sin hilos extra: no vale la pena despertar a nadie
+    int threads = GetThreadCount();
+    if (workers.empty() || count <= minChunk)
+    {
+        func(0, count);
+        return;
+    }
+
+    // Cuatro bloques por hilo para repartir mejor si algunos tardan mas
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &func;
+        jobCount = count;
+        chunkSize = std::max(minChunk, (count + threads * 4 - 1) / (threads * 4));
+        chunkCount = (count + chunkSize - 1) / chunkSize;
+        nextChunk = 0;
+        busyWorkers = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    RunChunks();
+
+    // Esperar a que todos los hilos suelten el lote antes de volver
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
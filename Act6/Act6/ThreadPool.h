@@ -0,0 +1,50 @@
+//-----------------------------------------------------
+//Pool de hilos fijo para repartir lotes de trabajo.
+//ParallelFor divide un rango en bloques, los hilos del
+//pool y el que llama los van tomando, y no vuelve hasta
+//que se termina el ultimo (fork-join)
+//-----------------------------------------------------
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;		// Hay un lote nuevo (o hay que salir)
+	std::condition_variable done;		// Un hilo termino su parte del lote
+
+	// Lote actual
+	const std::function<void(int, int)>* job;
+	int jobCount;
+	int chunkSize;
+	int chunkCount;
+	std::atomic<int> nextChunk;
+	unsigned int generation;	// Cambia con cada lote para despertar a los hilos
+	int busyWorkers;
+	bool quit;
+
+	void WorkerLoop();
+	void RunChunks();
+
+public:
+	// threadCount: hilos extra ademas del que llama. Negativo usa los
+	// nucleos disponibles menos uno; 0 deja todo en el hilo que llama
+	ThreadPool(int threadCount = -1);
+	~ThreadPool();
+
+	// Hilos que trabajan en cada lote, contando al que llama
+	int GetThreadCount() const { return (int)workers.size() + 1; }
+
+	// Ejecuta job(begin, end) sobre [0, count) en bloques de al menos
+	// minChunk elementos. Si el lote es chico corre entero en este hilo.
+	// No es reentrante: se llama siempre desde el mismo hilo
+	void ParallelFor(int count, int minChunk, const std::function<void(int, int)>& job);
+};
@@ -0,0 +1,54 @@
+//-----------------------------------------------------
+//Configuracion de Box2D para contar sus asignaciones.
+//Solo se usa si Box2D se compila con B2_USER_SETTINGS
+//definido y esta carpeta en el include path; el juego
+//tiene que compilarse con lo mismo porque cambia el
+//tipo de los userData. Sin eso b2Alloc queda en malloc
+//y solo se cuentan los new del juego
+//-----------------------------------------------------
+
+#pragma once
+#include "AllocationTracker.h"
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+// Los mismos valores que los de b2_settings.h
+#define b2_lengthUnitsPerMeter 1.0f
+#define b2_maxPolygonVertices 8
+
+struct b2BodyUserData
+{
+	b2BodyUserData() { pointer = 0; }
+	uintptr_t pointer;
+};
+
+struct b2FixtureUserData
+{
+	b2FixtureUserData() { pointer = 0; }
+	uintptr_t pointer;
+};
+
+struct b2JointUserData
+{
+	b2JointUserData() { pointer = 0; }
+	uintptr_t pointer;
+};
+
+inline void* b2Alloc(int32 size)
+{
+	return AllocationTracker::Allocate((size_t)size, Alloc_Box2D);
+}
+
+inline void b2Free(void* mem)
+{
+	AllocationTracker::Free(mem);
+}
+
+inline void b2Log(const char* string, ...)
+{
+	va_list args;
+	va_start(args, string);
+	std::vprintf(string, args);
+	va_end(args);
+}
@@ -1,5 +1,6 @@
 #include "Game.h"
 #include "Box2DHelper.h"
+#include <chrono>
 #include <iostream>
 
 // Constructor de la clase Game
@@ -22,8 +23,8 @@ void Game::Loop()
     {
         wnd->clear(clearColor); // Limpiar la ventana
         DoEvents(); // Procesar eventos de entrada
-        CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
+        CheckCollitions(); // Procesar los contactos del paso
         DrawGame(); // Dibujar el juego
         wnd->display(); // Mostrar la ventana
     }
@@ -65,15 +66,51 @@ void Game::DoEvents()
         case Event::Closed:
             wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
             break;
+        case Event::MouseButtonPressed:
+            // Agarrar el cuerpo bajo el cursor
+            if (evt.mouseButton.button == Mouse::Left) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseButton.x, evt.mouseButton.y));
+                picker.Grab(b2Vec2(pos.x, pos.y));
+            }
+            break;
+        case Event::MouseMoved:
+            if (picker.IsDragging()) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseMove.x, evt.mouseMove.y));
+                picker.Drag(b2Vec2(pos.x, pos.y));
+            }
+            break;
+        case Event::MouseButtonReleased:
+            if (evt.mouseButton.button == Mouse::Left)
+                picker.Release();
+            break;
+        case Event::KeyPressed:
+            // Volver al estado inicial sin reconstruir el mundo
+            if (evt.key.code == Keyboard::R)
+                ResetScene();
+            break;
         }
     }
 
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en un solo lote los eventos que el
+// listener guard durante el Step (el mundo ya no est bloqueado)
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    contactEvents.Drain([this](const ContactEvent& evt) {
+        switch (evt.type)
+        {
+        case ContactEvent_Begin:
+            contactCount++;
+            break;
+        case ContactEvent_End:
+            contactCount--;
+            break;
+        case ContactEvent_Impact:
+            impactCount++;
+            break;
+        }
+    });
 }
 
 // Configuracin de la vista del juego
@@ -97,6 +134,15 @@ void Game::InitPhysics()
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
+    // Registrar la cola de eventos de contacto
+    contactCount = 0;
+    impactCount = 0;
+    phyWorld->SetContactListener(&contactEvents);
+    phyWorld->SetDestructionListener(&contactEvents); // Olvida las fixtures destruidas con eventos pendientes
+
+    // Cuerpo ancla para arrastrar con el mouse
+    picker.Init(phyWorld);
+
     // Crear el suelo y las paredes estticas del mundo fsico
     b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
     groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
@@ -106,9 +152,28 @@ void Game::InitPhysics()
     fallingBlock = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 10, 10, 1.0f, 0.5f, 0.3f);
     fallingBlock->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f); // Posicin inicial del bloque
 
+    // Foto del estado inicial para reiniciar con la R
+    initialState.Capture(phyWorld);
+}
+
+// Vuelve los cuerpos al estado del inicio, escribindolo sobre los mismos
+// cuerpos: no se destruye ni se crea nada
+void Game::ResetScene()
+{
+    auto start = std::chrono::steady_clock::now();
+    picker.Release(); // El joint del mouse no es parte de la foto
+    initialState.Restore(phyWorld);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Reinicio: " << initialState.GetBodyCount() << " cuerpos en " << elapsed.count() << " ms\n";
 }
 
 // Destructor de la clase
 
 Game::~Game(void)
-{ }
\ No newline at end of file
+{
+    // El mundo destruye sus cuerpos y joints; la ventana se borra al final
+    // porque el renderer de debug dibuja sobre ella
+    delete phyWorld;
+    delete debugRender;
+    delete wnd;
+}
\ No newline at end of file
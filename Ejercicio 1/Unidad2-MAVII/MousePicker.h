@@ -0,0 +1,108 @@
+//-----------------------------------------------------
+//Agarrar y arrastrar cuerpos con el mouse. El cuerpo
+//bajo el cursor se busca con una consulta AABB chica
+//en el arbol dinamico (O(log n)) y prueba exacta con
+//TestPoint; despues lo lleva un b2MouseJoint
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+
+class MousePicker
+{
+private:
+	// Callback de la consulta: se queda con el primer cuerpo dinamico que
+	// contiene el punto y corta la busqueda
+	struct PickCallback : public b2QueryCallback
+	{
+		b2Vec2 point;
+		b2Body* body;
+
+		bool ReportFixture(b2Fixture* fixture) override
+		{
+			b2Body* candidate = fixture->GetBody();
+			if (candidate->GetType() != b2_dynamicBody || !fixture->TestPoint(point))
+				return true;
+			body = candidate;
+			return false;
+		}
+	};
+
+	b2World* phyWorld;
+	b2Body* anchor;			// Cuerpo estatico sin fixtures, el otro extremo del joint
+	b2MouseJoint* joint;
+
+public:
+	MousePicker()
+	{
+		phyWorld = nullptr;
+		anchor = nullptr;
+		joint = nullptr;
+	}
+
+	// Se llama una vez, despues de crear el mundo
+	void Init(b2World* world)
+	{
+		phyWorld = world;
+		b2BodyDef anchorDef;
+		anchor = phyWorld->CreateBody(&anchorDef);
+		joint = nullptr;
+	}
+
+	// Cuerpo dinamico bajo el punto (en metros), o nullptr
+	b2Body* PickBody(const b2Vec2& point) const
+	{
+		PickCallback callback;
+		callback.point = point;
+		callback.body = nullptr;
+
+		b2AABB box;
+		box.lowerBound.Set(point.x - 0.001f, point.y - 0.001f);
+		box.upperBound.Set(point.x + 0.001f, point.y + 0.001f);
+		phyWorld->QueryAABB(&callback, box);
+		return callback.body;
+	}
+
+	// Si el cuerpo agarrado se destruyo, Box2D ya borro el joint; el ancla
+	// solo tiene ese joint, asi que alcanza con mirar su lista
+	bool IsDragging()
+	{
+		if (joint && anchor->GetJointList() == nullptr)
+			joint = nullptr;
+		return joint != nullptr;
+	}
+
+	// Agarra el cuerpo bajo el punto. Devuelve false si no hay ninguno
+	bool Grab(const b2Vec2& point)
+	{
+		Release();
+		b2Body* body = PickBody(point);
+		if (!body)
+			return false;
+
+		b2MouseJointDef jointDef;
+		jointDef.bodyA = anchor;
+		jointDef.bodyB = body;
+		jointDef.target = point;
+		jointDef.maxForce = 1000.0f * body->GetMass();
+		b2LinearStiffness(jointDef.stiffness, jointDef.damping, 5.0f, 0.7f, anchor, body);
+		joint = (b2MouseJoint*)phyWorld->CreateJoint(&jointDef);
+		body->SetAwake(true);
+		return true;
+	}
+
+	// Mueve el objetivo del joint (el cuerpo lo sigue en el proximo Step)
+	void Drag(const b2Vec2& point)
+	{
+		if (IsDragging())
+			joint->SetTarget(point);
+	}
+
+	// Suelta el cuerpo; conserva la velocidad que traia, asi se puede tirar
+	void Release()
+	{
+		if (IsDragging())
+			phyWorld->DestroyJoint(joint);
+		joint = nullptr;
+	}
+};
@@ -1,5 +1,6 @@
 #include "Game.h"
 #include "Box2DHelper.h"
+#include <chrono>
 #include <iostream>
 
 // Constructor de la clase Game
@@ -11,6 +12,8 @@ Game::Game(int ancho, int alto, std::string titulo)
     fps = 60;
     wnd->setFramerateLimit(fps);
     frameTime = 1.0f / fps;
+    paused = false;
+    rewindFrame = 0;
     SetZoom(); // Configuracin de la vista del juego
     InitPhysics(); // Inicializacin del motor de fsica
 }
@@ -22,8 +25,8 @@ void Game::Loop()
     {
         wnd->clear(clearColor); // Limpiar la ventana
         DoEvents(); // Procesar eventos de entrada
-        CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
+        CheckCollitions(); // Procesar los contactos del paso
         DrawGame(); // Dibujar el juego
         wnd->display(); // Mostrar la ventana
     }
@@ -32,8 +35,13 @@ void Game::Loop()
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
-    phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
+    if (!paused)
+    {
+        impacts.BeginStep(); // Olvidar los impulsos del paso anterior
+        phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+        phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
+        rewind.Record(phyWorld); // Guardar el paso en el historial
+    }
     phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
 }
 
@@ -59,7 +67,7 @@ void Game::DrawGame()
 
     // Dibujar el cuerpo de control (crculo)
     sf::CircleShape controlShape(5);
-    controlShape.setFillColor(sf::Color::Magenta);
+    controlShape.setFillColor(flashFrames > 0 ? sf::Color::White : sf::Color::Magenta);
     controlShape.setPosition(controlBody->GetPosition().x - 5, controlBody->GetPosition().y - 5);
     wnd->draw(controlShape);
 }
@@ -75,14 +83,64 @@ void Game::DoEvents()
         case Event::Closed:
             wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
             break;
+        case Event::MouseButtonPressed:
+            // Agarrar el cuerpo bajo el cursor
+            if (evt.mouseButton.button == Mouse::Left) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseButton.x, evt.mouseButton.y));
+                picker.Grab(b2Vec2(pos.x, pos.y));
+            }
+            break;
+        case Event::MouseMoved:
+            if (picker.IsDragging()) {
+                Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseMove.x, evt.mouseMove.y));
+                picker.Drag(b2Vec2(pos.x, pos.y));
+            }
+            break;
+        case Event::MouseButtonReleased:
+            if (evt.mouseButton.button == Mouse::Left)
+                picker.Release();
+            break;
+        case Event::KeyPressed:
+            // Volver al estado inicial sin reconstruir el mundo
+            if (evt.key.code == Keyboard::R)
+                ResetScene();
+            // Pausa y recorrido del historial (con Shift de a 10 frames)
+            if (evt.key.code == Keyboard::P)
+                TogglePause();
+            if (evt.key.code == Keyboard::Left)
+                Scrub(evt.key.shift ? -10 : -1);
+            if (evt.key.code == Keyboard::Right)
+                Scrub(evt.key.shift ? 10 : 1);
+            break;
         }
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en un solo lote los eventos que el
+// listener guard durante el Step (el mundo ya no est bloqueado)
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    contactEvents.Drain([this](const ContactEvent& evt) {
+        switch (evt.type)
+        {
+        case ContactEvent_Begin:
+            contactCount++;
+            break;
+        case ContactEvent_End:
+            contactCount--;
+            break;
+        case ContactEvent_Impact:
+            impactCount++;
+            break;
+        }
+    });
+
+    // Golpe fuerte de la pelota contra las paredes con restitucin 3:
+    // se lee el impulso ya acumulado en su slot
+    if (flashFrames > 0)
+        flashFrames--;
+    if (impacts.GetImpact(controlBody).maxImpulse > 500.0f)
+        flashFrames = 6;
 }
 
 // Configuracin de la vista del juego
@@ -106,6 +164,20 @@ void Game::InitPhysics()
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
+    // Registrar la cola de eventos de contacto
+    contactCount = 0;
+    impactCount = 0;
+    phyWorld->SetContactListener(&contactEvents);
+    phyWorld->SetDestructionListener(&contactEvents); // Olvida las fixtures destruidas con eventos pendientes
+
+    // Cuerpo ancla para arrastrar con el mouse
+    picker.Init(phyWorld);
+
+    // Estadsticas de impacto por cuerpo, encadenadas detrs de la cola
+    flashFrames = 0;
+    contactEvents.SetNext(&impacts);
+    contactEvents.SetNextDestruction(&impacts);
+
     // Crear el suelo y las paredes estticas del mundo fsico
     b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
     groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
@@ -133,9 +205,56 @@ void Game::InitPhysics()
     // Crear un crculo que se controlar con el teclado
     controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 0.1f);
     controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+
+    // Foto del estado inicial para reiniciar con la R
+    initialState.Capture(phyWorld);
+}
+
+// Vuelve los cuerpos al estado del inicio, escribindolo sobre los mismos
+// cuerpos: no se destruye ni se crea nada
+void Game::ResetScene()
+{
+    auto start = std::chrono::steady_clock::now();
+    picker.Release(); // El joint del mouse no es parte de la foto
+    initialState.Restore(phyWorld);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Reinicio: " << initialState.GetBodyCount() << " cuerpos en " << elapsed.count() << " ms\n";
+}
+
+// Pausa la simulacin o la retoma desde el frame que se est mostrando;
+// los frames posteriores se descartan porque desde ah la historia cambia
+void Game::TogglePause()
+{
+    if (!paused)
+    {
+        paused = true;
+        rewindFrame = rewind.GetFrameCount() - 1;
+        std::cout << "Pausa: " << rewind.GetFrameCount() << " frames, " << rewind.GetUsedBytes() / 1024 << " KB\n";
+    }
+    else
+    {
+        rewind.DiscardAfter(rewindFrame);
+        paused = false;
+    }
+}
+
+// En pausa, mueve el frame mostrado y lo escribe en el mundo
+void Game::Scrub(int frames)
+{
+    if (!paused || rewind.GetFrameCount() == 0)
+        return;
+    rewindFrame = b2Clamp(rewindFrame + frames, 0, rewind.GetFrameCount() - 1);
+    rewind.Restore(phyWorld, rewindFrame);
+    std::cout << "Frame " << rewindFrame + 1 << "/" << rewind.GetFrameCount() << " (" << (rewindFrame + 1 - rewind.GetFrameCount()) * frameTime << " s)\n";
 }
 
 // Destructor de la clase
 
 Game::~Game(void)
-{ }
\ No newline at end of file
+{
+    // El mundo destruye sus cuerpos y joints; la ventana se borra al final
+    // porque el renderer de debug dibuja sobre ella
+    delete phyWorld;
+    delete debugRender;
+    delete wnd;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+//-----------------------------------------------------
+//Estadisticas de impacto por cuerpo. En PostSolve se
+//acumula el impulso normal maximo y total de cada
+//cuerpo en un arreglo plano indexado por un slot, asi
+//despues del Step se piden los K golpes mas fuertes
+//sin volver a recorrer los contactos
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Impacto acumulado de un cuerpo durante el ultimo paso
+struct BodyImpact
+{
+	b2Body* body;
+	float maxImpulse;		// Mayor impulso normal de un solo contacto (N*s)
+	float totalImpulse;		// Suma de los impulsos normales de todos sus contactos
+	int contacts;			// Cantidad de contactos resueltos
+};
+
+class ImpactStats : public b2ContactListener, public b2DestructionListener
+{
+private:
+	std::vector<BodyImpact> slots;
+	std::vector<int> freeSlots;
+	std::vector<int> touched;		// Slots con impulso en este paso
+
+	void Accumulate(b2Body* body, float maxImpulse, float totalImpulse);
+
+public:
+	ImpactStats();
+
+	// Slot del cuerpo guardado en userData.pointer (slot + 1), -1 si no tiene
+	static int GetSlot(const b2Body* body);
+
+	// Asigna un slot al cuerpo (si ya tenia devuelve el mismo)
+	int Acquire(b2Body* body);
+
+	// Libera el slot para reusarlo. Se llama solo al destruir el cuerpo
+	// gracias a SayGoodbye, no hace falta llamarlo a mano
+	void Release(b2Body* body);
+
+	// Pone en cero los slots tocados en el paso anterior. Va antes de Step()
+	void BeginStep();
+
+	// Registrar con b2World::SetContactListener o encadenado detras de
+	// ContactEventQueue::SetNext
+	void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+
+	// Registrar con b2World::SetDestructionListener o encadenado detras de
+	// ContactEventQueue::SetNextDestruction
+	void SayGoodbye(b2Joint* joint) override {}
+	void SayGoodbye(b2Fixture* fixture) override;
+
+	// Los k impactos mas fuertes del ultimo paso (por impulso maximo), de
+	// mayor a menor, ignorando los que no llegan a minImpulse. Devuelve
+	// cuantos se copiaron en out
+	int GetTopImpacts(int k, std::vector<BodyImpact>& out, float minImpulse = 0.0f) const;
+
+	// Impacto del cuerpo en el ultimo paso (ceros si no tuvo contactos)
+	BodyImpact GetImpact(const b2Body* body) const;
+
+	int GetSlotCount() const { return (int)(slots.size() - freeSlots.size()); }
+};
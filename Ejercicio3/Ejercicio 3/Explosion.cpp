@@ -0,0 +1,90 @@
+#include "Explosion.h"
+#include <algorithm>
+#include <cmath>
+
+// Junta los cuerpos dinamicos de las fixtures que tocan la caja
+struct GatherCallback : public b2QueryCallback
+{
+    std::vector<b2Body*>* bodies;
+
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        b2Body* body = fixture->GetBody();
+        if (body->GetType() == b2_dynamicBody)
+            bodies->push_back(body);
+        return true;
+    }
+};
+
+// Constructor de la clase Explosion
+Explosion::Explosion(b2World* world)
+{
+    phyWorld = world;
+    bodies.reserve(128);
+}
+
+void Explosion::Gather(const b2AABB& box)
+{
+    bodies.clear();
+    GatherCallback callback;
+    callback.bodies = &bodies;
+    phyWorld->QueryAABB(&callback, box);
+
+    // Un cuerpo con varias fixtures aparece varias veces
+    std::sort(bodies.begin(), bodies.end());
+    bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+}
+
+int Explosion::ApplyRadialImpulse(const b2Vec2& center, float radius, float strength, ImpulseFalloff falloff)
+{
+    if (radius <= 0.0f)
+        return 0;
+
+    b2AABB box;
+    box.lowerBound.Set(center.x - radius, center.y - radius);
+    box.upperBound.Set(center.x + radius, center.y + radius);
+    Gather(box);
+
+    int count = (int)bodies.size();
+    posX.resize(count);
+    posY.resize(count);
+    impulseX.resize(count);
+    impulseY.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const b2Vec2& pos = bodies[i]->GetWorldCenter();
+        posX[i] = pos.x - center.x;
+        posY[i] = pos.y - center.y;
+    }
+
+    // Atenuacion sin ramas: fuera del radio t queda en cero. El modo se
+    // traduce antes del bucle a dos factores 0/1 (t^0, t^1 o t^2)
+    float usePow1 = falloff != Falloff_None ? 1.0f : 0.0f;
+    float usePow2 = falloff == Falloff_Quadratic ? 1.0f : 0.0f;
+    float invRadius = 1.0f / radius;
+    const float* px = posX.data();
+    const float* py = posY.data();
+    float* ix = impulseX.data();
+    float* iy = impulseY.data();
+    for (int i = 0; i < count; ++i)
+    {
+        float dist = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+        float t = std::max(0.0f, 1.0f - dist * invRadius);
+        float inside = t > 0.0f ? 1.0f : 0.0f;
+        float factor = inside * (1.0f - usePow1 + usePow1 * t) * (1.0f - usePow2 + usePow2 * t);
+        float scale = strength * factor / std::max(dist, 0.001f);
+        ix[i] = px[i] * scale;
+        iy[i] = py[i] * scale;
+    }
+
+    // Una sola pasada para aplicar
+    int pushed = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (ix[i] == 0.0f && iy[i] == 0.0f)
+            continue;
+        bodies[i]->ApplyLinearImpulseToCenter(b2Vec2(ix[i], iy[i]), true);
+        pushed++;
+    }
+    return pushed;
+}
@@ -0,0 +1,43 @@
+//-----------------------------------------------------
+//Impulso radial (explosiones). Los cuerpos afectados se
+//juntan con una consulta AABB del radio, en vez de
+//recorrer GetBodyList(), y la atenuacion se calcula en
+//un bucle sin ramas sobre arreglos separados (SoA) que
+//el compilador puede vectorizar. El costo depende de
+//cuantos cuerpos toca la explosion, no del mundo
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Como baja el impulso con la distancia al centro
+enum ImpulseFalloff
+{
+	Falloff_None = 0,		// Igual en todo el radio
+	Falloff_Linear,			// 1 - d/r
+	Falloff_Quadratic		// (1 - d/r)^2
+};
+
+class Explosion
+{
+private:
+	b2World* phyWorld;
+
+	// Cuerpos juntados por la consulta y sus datos en arreglos separados
+	std::vector<b2Body*> bodies;
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> impulseX;
+	std::vector<float> impulseY;
+
+	void Gather(const b2AABB& box);
+
+public:
+	Explosion(b2World* world);
+
+	// Aplica a cada cuerpo dinamico dentro del radio un impulso que lo aleja
+	// del centro: strength en el centro, atenuado segun falloff hasta cero
+	// en el borde. Llamar fuera del Step. Devuelve cuantos cuerpos empujo
+	int ApplyRadialImpulse(const b2Vec2& center, float radius, float strength, ImpulseFalloff falloff);
+};
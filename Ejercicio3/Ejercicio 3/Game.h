@@ -2,6 +2,11 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactEventQueue.h"
+#include "Explosion.h"
+#include "MousePicker.h"
+#include "RewindBuffer.h"
+#include "WorldSnapshot.h"
 #include <list>
 
 using namespace sf;
@@ -18,6 +23,25 @@ private:
 	b2World* phyWorld;
 	SFMLRenderer* debugRender;
 
+	// Eventos de contacto del ltimo paso, se procesan en CheckCollitions
+	ContactEventQueue contactEvents;
+	int contactCount;	// Pares tocndose ahora
+	int impactCount;	// Golpes fuertes desde el inicio
+
+	// Arrastrar cuerpos con el botn izquierdo
+	MousePicker picker;
+
+	// Estado inicial de los cuerpos, la R vuelve a l
+	WorldSnapshot initialState;
+
+	// Explosin con el botn derecho
+	Explosion* explosion;
+
+	// Historial de los ltimos 10 segundos: P pausa, flechas recorren
+	RewindBuffer rewind;
+	bool paused;
+	int rewindFrame;	// Frame mostrado mientras est en pausa
+
 	//tiempo de frame
 	float frameTime;
 	int fps;
@@ -32,6 +56,9 @@ public:
 	void CheckCollitions();
 	~Game(void);
 	void InitPhysics();
+	void ResetScene();
+	void TogglePause();
+	void Scrub(int frames);
 
 	// Main game loop
 	void Loop();
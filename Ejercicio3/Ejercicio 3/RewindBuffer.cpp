@@ -0,0 +1,316 @@
+#include "RewindBuffer.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+// Escalas de cuantizacion de cada campo de QuantizedBodyState
+static const float fieldScale[6] = { 1024.0f, 1024.0f, 8192.0f, 256.0f, 256.0f, 256.0f };
+static const uint8 flagsChanged = 1 << 6;	// Bit de la mascara para las banderas
+
+static int32 Quantize(float value, float scale)
+{
+    double scaled = std::floor((double)value * scale + 0.5);
+    scaled = std::min(std::max(scaled, (double)INT_MIN), (double)INT_MAX);
+    return (int32)scaled;
+}
+
+// Enteros con signo como varint: zigzag y 7 bits por byte
+static void WriteVarint(std::vector<uint8>& out, int32 value)
+{
+    uint32 zigzag = ((uint32)value << 1) ^ (uint32)(value >> 31);
+    while (zigzag >= 0x80)
+    {
+        out.push_back((uint8)(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    out.push_back((uint8)zigzag);
+}
+
+static int32 ReadVarint(const uint8*& in)
+{
+    uint32 zigzag = 0;
+    int shift = 0;
+    uint8 byte;
+    do
+    {
+        byte = *in++;
+        zigzag |= (uint32)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return (int32)(zigzag >> 1) ^ -(int32)(zigzag & 1);
+}
+
+// Constructor de la clase RewindBuffer
+RewindBuffer::RewindBuffer(size_t byteCapacity, int maxFrames, int keyframeInterval)
+{
+    bytes.resize(byteCapacity);
+    frames.resize(maxFrames > 0 ? maxFrames : 1);
+    this->keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+    nextId = 1;
+    Clear();
+}
+
+void RewindBuffer::Clear()
+{
+    writePos = 0;
+    firstFrame = 0;
+    frameCount = 0;
+    sinceKeyframe = 0;
+    forceKeyframe = true;
+    previousIds.clear();
+    previousStates.clear();
+    bodyIds.clear();
+}
+
+// Numero que el ultimo Record le dio al cuerpo, 0 si no estaba
+uint32 RewindBuffer::FindId(b2Body* body) const
+{
+    BodyId key = { body, 0 };
+    auto it = std::lower_bound(bodyIds.begin(), bodyIds.end(), key, ByBody);
+    return (it != bodyIds.end() && it->body == body) ? it->id : 0;
+}
+
+size_t RewindBuffer::GetUsedBytes() const
+{
+    size_t used = 0;
+    for (int i = 0; i < frameCount; ++i)
+        used += frames[(firstFrame + i) % frames.size()].size;
+    return used;
+}
+
+void RewindBuffer::Record(b2World* world)
+{
+    currentIds.clear();
+    currentStates.clear();
+    nextBodyIds.clear();
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        b2Vec2 position = body->GetPosition();
+        b2Vec2 velocity = body->GetLinearVelocity();
+        float raw[6] = { position.x, position.y, body->GetAngle(), velocity.x, velocity.y, body->GetAngularVelocity() };
+
+        QuantizedBodyState state;
+        for (int f = 0; f < 6; ++f)
+            state.values[f] = Quantize(raw[f], fieldScale[f]);
+        state.flags = (body->IsAwake() ? 1 : 0) | (body->IsEnabled() ? 2 : 0);
+
+        uint32 id = FindId(body);
+        if (id == 0)
+            id = nextId++;
+        BodyId entry = { body, id };
+        nextBodyIds.push_back(entry);
+        currentIds.push_back(id);
+        currentStates.push_back(state);
+    }
+    std::sort(nextBodyIds.begin(), nextBodyIds.end(), ByBody);
+
+    // Con otra lista de cuerpos (balas nuevas o destruidas) no hay contra
+    // que comparar: va un frame completo
+    bool keyframe = forceKeyframe || sinceKeyframe + 1 >= keyframeInterval || currentIds != previousIds;
+    Encode(keyframe);
+    Append(keyframe);
+
+    previousIds.swap(currentIds);
+    previousStates.swap(currentStates);
+    bodyIds.swap(nextBodyIds);
+}
+
+// Arma en record el frame actual. Formato: tipo (1 clave), cantidad de
+// cuerpos, los numeros de cuerpo si es clave y por cuerpo una mascara de
+// campos cambiados seguida de las diferencias como varint
+void RewindBuffer::Encode(bool keyframe)
+{
+    record.clear();
+    record.push_back(keyframe ? 1 : 0);
+    WriteVarint(record, (int32)currentIds.size());
+    if (keyframe)
+    {
+        size_t start = record.size();
+        record.resize(start + currentIds.size() * sizeof(uint32));
+        if (!currentIds.empty())
+            std::memcpy(&record[start], currentIds.data(), currentIds.size() * sizeof(uint32));
+    }
+
+    static const QuantizedBodyState zero = {};
+    for (size_t i = 0; i < currentStates.size(); ++i)
+    {
+        const QuantizedBodyState& state = currentStates[i];
+        const QuantizedBodyState& base = keyframe ? zero : previousStates[i];
+
+        uint8 mask = 0;
+        for (int f = 0; f < 6; ++f)
+        {
+            if (state.values[f] != base.values[f])
+                mask |= 1 << f;
+        }
+        if (state.flags != base.flags)
+            mask |= flagsChanged;
+
+        record.push_back(mask);
+        for (int f = 0; f < 6; ++f)
+        {
+            if (mask & (1 << f))
+                WriteVarint(record, (int32)((uint32)state.values[f] - (uint32)base.values[f]));
+        }
+        if (mask & flagsChanged)
+            record.push_back(state.flags);
+    }
+}
+
+void RewindBuffer::PopOldest()
+{
+    firstFrame = (firstFrame + 1) % (int)frames.size();
+    frameCount--;
+}
+
+// Copia record al buffer circular. Los frames se guardan contiguos: si no
+// entra al final se vuelve al principio y se pisan los mas viejos
+void RewindBuffer::Append(bool keyframe)
+{
+    size_t size = record.size();
+    if (size > bytes.size())
+    {
+        // Ni vacio entra: se pierde la historia y se reintenta con un frame clave
+        Clear();
+        return;
+    }
+
+    if (frameCount == (int)frames.size())
+        PopOldest();
+
+    if (writePos + size > bytes.size())
+    {
+        // Lo que quedaba al final del buffer son los frames mas viejos
+        while (frameCount > 0 && GetFrame(0).offset >= writePos)
+            PopOldest();
+        writePos = 0;
+    }
+    while (frameCount > 0)
+    {
+        const FrameInfo& oldest = GetFrame(0);
+        if (oldest.offset >= writePos + size || oldest.offset + oldest.size <= writePos)
+            break;
+        PopOldest();
+    }
+
+    // Un frame diferencial sin su frame clave no se puede decodificar
+    while (frameCount > 0 && !GetFrame(0).keyframe)
+        PopOldest();
+
+    std::memcpy(&bytes[writePos], record.data(), size);
+    FrameInfo& info = frames[(firstFrame + frameCount) % frames.size()];
+    info.offset = writePos;
+    info.size = (uint32)size;
+    info.keyframe = keyframe;
+    frameCount++;
+    writePos += size;
+
+    forceKeyframe = false;
+    sinceKeyframe = keyframe ? 0 : sinceKeyframe + 1;
+}
+
+// Decodifica desde el frame clave anterior hasta el pedido
+bool RewindBuffer::Decode(int frame)
+{
+    if (frame < 0 || frame >= frameCount)
+        return false;
+
+    int key = frame;
+    while (!GetFrame(key).keyframe)
+        key--;
+
+    for (int i = key; i <= frame; ++i)
+    {
+        const FrameInfo& info = GetFrame(i);
+        const uint8* in = &bytes[info.offset];
+        bool keyframe = *in++ != 0;
+        int count = ReadVarint(in);
+        if (keyframe)
+        {
+            decodedIds.resize(count);
+            decodedStates.assign(count, QuantizedBodyState());
+            if (count > 0)
+                std::memcpy(decodedIds.data(), in, count * sizeof(uint32));
+            in += count * sizeof(uint32);
+        }
+
+        for (int b = 0; b < count; ++b)
+        {
+            QuantizedBodyState& state = decodedStates[b];
+            uint8 mask = *in++;
+            for (int f = 0; f < 6; ++f)
+            {
+                if (mask & (1 << f))
+                    state.values[f] = (int32)((uint32)state.values[f] + (uint32)ReadVarint(in));
+            }
+            if (mask & flagsChanged)
+                state.flags = *in++;
+        }
+    }
+    return true;
+}
+
+bool RewindBuffer::Restore(b2World* world, int frame)
+{
+    if (world->IsLocked() || !Decode(frame))
+        return false;
+
+    // Solo se tocan los cuerpos que siguen vivos con el mismo numero. Los
+    // creados despues del ultimo Record no tienen numero y no se tocan
+    liveIds.clear();
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        BodyId entry = { body, FindId(body) };
+        if (entry.id != 0)
+            liveIds.push_back(entry);
+    }
+    std::sort(liveIds.begin(), liveIds.end(), ById);
+
+    for (size_t i = 0; i < decodedIds.size(); ++i)
+    {
+        BodyId key = { nullptr, decodedIds[i] };
+        auto live = std::lower_bound(liveIds.begin(), liveIds.end(), key, ById);
+        if (live == liveIds.end() || live->id != key.id)
+            continue;
+        b2Body* body = live->body;
+
+        const QuantizedBodyState& state = decodedStates[i];
+        float value[6];
+        for (int f = 0; f < 6; ++f)
+            value[f] = state.values[f] / fieldScale[f];
+
+        bool enabled = (state.flags & 2) != 0;
+        if (body->IsEnabled() != enabled)
+            body->SetEnabled(enabled);
+        body->SetTransform(b2Vec2(value[0], value[1]), value[2]);
+        if (state.flags & 1)
+        {
+            body->SetAwake(true);
+            body->SetLinearVelocity(b2Vec2(value[3], value[4]));
+            body->SetAngularVelocity(value[5]);
+        }
+        else
+            body->SetAwake(false);
+    }
+
+    // El proximo Record compara contra lo que quedo en el mundo
+    forceKeyframe = true;
+    return true;
+}
+
+void RewindBuffer::DiscardAfter(int frame)
+{
+    if (frame < 0)
+    {
+        Clear();
+        return;
+    }
+    if (frame >= frameCount)
+        return;
+
+    frameCount = frame + 1;
+    const FrameInfo& last = GetFrame(frame);
+    writePos = last.offset + last.size;
+    forceKeyframe = true;
+}
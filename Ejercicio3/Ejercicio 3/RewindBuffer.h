@@ -0,0 +1,105 @@
+//-----------------------------------------------------
+//Historial de los ultimos pasos del mundo para volver
+//atras en el tiempo. Cada frame guarda el estado de los
+//cuerpos cuantizado a enteros y codificado como
+//diferencia con el frame anterior (un cuerpo quieto
+//ocupa un byte). Cada tantos frames, o cuando cambia la
+//lista de cuerpos, va un frame clave completo. Todo
+//vive en un buffer circular de tamao fijo: cuando se
+//llena se pisan los frames mas viejos. Los cuerpos se
+//identifican con un numero propio y no por direccion:
+//una bala nueva puede ocupar la memoria de una vieja
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <cstddef>
+#include <vector>
+
+// Estado de un cuerpo cuantizado: posicion en mm, angulo en 1/8192 rad,
+// velocidades en 1/256 m/s y rad/s
+struct QuantizedBodyState
+{
+	int32 values[6];		// x, y, angulo, vx, vy, w
+	uint8 flags;			// 1 despierto, 2 habilitado
+};
+
+class RewindBuffer
+{
+private:
+	struct FrameInfo
+	{
+		size_t offset;		// Dentro de bytes
+		uint32 size;
+		bool keyframe;
+	};
+
+	// Numero de un cuerpo. Un cuerpo que no estaba en el Record anterior
+	// recibe uno nuevo aunque su direccion sea la de uno destruido
+	struct BodyId
+	{
+		b2Body* body;
+		uint32 id;
+	};
+
+	std::vector<uint8> bytes;			// Buffer circular de frames codificados
+	size_t writePos;
+	std::vector<FrameInfo> frames;		// Anillo de maxFrames entradas
+	int firstFrame;
+	int frameCount;
+	int keyframeInterval;
+	int sinceKeyframe;
+	bool forceKeyframe;
+
+	// Ultimo frame grabado, contra el que se codifica el siguiente
+	std::vector<uint32> previousIds;
+	std::vector<QuantizedBodyState> previousStates;
+	std::vector<uint32> currentIds;
+	std::vector<QuantizedBodyState> currentStates;
+	std::vector<uint8> record;
+
+	// Numeros del ultimo Record ordenados por direccion, y el proximo libre
+	std::vector<BodyId> bodyIds;
+	std::vector<BodyId> nextBodyIds;
+	uint32 nextId;
+
+	// Frame decodificado por Restore y cuerpos vivos (ordenados por numero)
+	std::vector<uint32> decodedIds;
+	std::vector<QuantizedBodyState> decodedStates;
+	std::vector<BodyId> liveIds;
+
+	FrameInfo& GetFrame(int frame) { return frames[(firstFrame + frame) % frames.size()]; }
+	void Encode(bool keyframe);
+	void Append(bool keyframe);
+	void PopOldest();
+	bool Decode(int frame);
+	uint32 FindId(b2Body* body) const;
+	static bool ByBody(const BodyId& a, const BodyId& b) { return a.body < b.body; }
+	static bool ById(const BodyId& a, const BodyId& b) { return a.id < b.id; }
+
+public:
+	// byteCapacity: memoria total para los frames codificados
+	// maxFrames: cuantos pasos como maximo (segundos * fps)
+	// keyframeInterval: cada cuantos frames va uno completo
+	RewindBuffer(size_t byteCapacity = 8 * 1024 * 1024, int maxFrames = 600, int keyframeInterval = 60);
+
+	// Graba el estado actual de todos los cuerpos. Se llama despues del Step
+	void Record(b2World* world);
+
+	// Escribe en el mundo el frame pedido (0 es el mas viejo). Los cuerpos
+	// de ese frame que ya no existen se saltean y los creados despues se
+	// dejan como estan. Un cuerpo destruido y otro creado en su memoria
+	// entre dos Record no se distinguen: quien destruya cuerpos sin grabar
+	// despues (por ejemplo en pausa) tiene que llamar a Clear
+	bool Restore(b2World* world, int frame);
+
+	// Descarta los frames posteriores, para seguir grabando desde ahi
+	// despues de volver atras
+	void DiscardAfter(int frame);
+
+	void Clear();
+
+	int GetFrameCount() const { return frameCount; }
+	size_t GetUsedBytes() const;
+	size_t GetCapacity() const { return bytes.size(); }
+};
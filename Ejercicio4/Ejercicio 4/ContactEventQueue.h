@@ -0,0 +1,171 @@
+//-----------------------------------------------------
+//Cola de eventos de contacto. Box2D llama al listener
+//durante el Step() y aca solo se copian registros
+//chicos a un buffer circular reservado de antemano.
+//Game::CheckCollitions() los procesa todos juntos
+//despues del paso. Conviene vaciarla antes de cualquier
+//DestroyBody; si no, la cola tiene que estar registrada
+//como destruction listener para olvidar las fixtures
+//que se liberan (DestroyBody ademas encola los End de
+//los contactos del cuerpo que esta por destruir)
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+enum ContactEventType
+{
+	ContactEvent_Begin = 0,		// Dos fixtures empiezan a tocarse
+	ContactEvent_End,			// Dejan de tocarse
+	ContactEvent_Impact			// Golpe con impulso normal mayor al umbral
+};
+
+// Registro compacto de un evento (32 bytes en 64 bits). Las fixtures
+// destruidas con el evento pendiente quedan en nullptr
+struct ContactEvent
+{
+	b2Fixture* fixtureA;
+	b2Fixture* fixtureB;
+	b2Vec2 point;		// Punto de contacto en el mundo (cero en End)
+	float impulse;		// Impulso normal maximo (solo en Impact)
+	int type;			// ContactEventType
+};
+
+class ContactEventQueue : public b2ContactListener, public b2DestructionListener
+{
+private:
+	std::vector<ContactEvent> events;
+	unsigned int mask;
+	unsigned int head;		// Proximo evento a leer
+	unsigned int tail;		// Proximo lugar a escribir
+	int dropped;
+	float impactThreshold;
+	b2ContactListener* next;	// Box2D acepta un solo listener; los demas se encadenan aca
+	b2DestructionListener* nextDestruction;
+
+	// Agrega un evento; si el buffer esta lleno se descarta y se cuenta
+	void Push(int type, b2Fixture* fixtureA, b2Fixture* fixtureB, const b2Vec2& point, float impulse)
+	{
+		if (tail - head > mask)
+		{
+			dropped++;
+			return;
+		}
+		ContactEvent& evt = events[tail & mask];
+		evt.fixtureA = fixtureA;
+		evt.fixtureB = fixtureB;
+		evt.point = point;
+		evt.impulse = impulse;
+		evt.type = type;
+		tail++;
+	}
+
+	// Primer punto de contacto en coordenadas del mundo
+	static b2Vec2 WorldPoint(b2Contact* contact)
+	{
+		if (contact->GetManifold()->pointCount == 0)
+			return b2Vec2(0.0f, 0.0f);
+		b2WorldManifold worldManifold;
+		contact->GetWorldManifold(&worldManifold);
+		return worldManifold.points[0];
+	}
+
+public:
+	// capacity se redondea a potencia de dos para indexar con una mascara.
+	// impactThreshold: impulso normal (N*s) desde el que se registra un golpe
+	ContactEventQueue(int capacity = 8192, float threshold = 5.0f)
+	{
+		unsigned int size = 1;
+		while (size < (unsigned int)capacity)
+			size <<= 1;
+		events.resize(size);
+		mask = size - 1;
+		head = 0;
+		tail = 0;
+		dropped = 0;
+		impactThreshold = threshold;
+		next = nullptr;
+		nextDestruction = nullptr;
+	}
+
+	void SetImpactThreshold(float threshold) { impactThreshold = threshold; }
+
+	// Otro listener que recibe los mismos callbacks despues de la cola
+	void SetNext(b2ContactListener* listener) { next = listener; }
+
+	// Otro destruction listener que recibe los avisos despues de la cola
+	void SetNextDestruction(b2DestructionListener* listener) { nextDestruction = listener; }
+
+	// Callbacks de b2ContactListener (se ejecutan dentro del Step)
+	void BeginContact(b2Contact* contact) override
+	{
+		Push(ContactEvent_Begin, contact->GetFixtureA(), contact->GetFixtureB(), WorldPoint(contact), 0.0f);
+		if (next)
+			next->BeginContact(contact);
+	}
+
+	void EndContact(b2Contact* contact) override
+	{
+		Push(ContactEvent_End, contact->GetFixtureA(), contact->GetFixtureB(), b2Vec2(0.0f, 0.0f), 0.0f);
+		if (next)
+			next->EndContact(contact);
+	}
+
+	void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override
+	{
+		float maxImpulse = 0.0f;
+		for (int i = 0; i < impulse->count; ++i)
+			maxImpulse = b2Max(maxImpulse, impulse->normalImpulses[i]);
+		if (maxImpulse >= impactThreshold)
+			Push(ContactEvent_Impact, contact->GetFixtureA(), contact->GetFixtureB(), WorldPoint(contact), maxImpulse);
+		if (next)
+			next->PostSolve(contact, impulse);
+	}
+
+	// Callbacks de b2DestructionListener. DestroyBody avisa por cada fixture
+	// despues de encolar los End de sus contactos: los eventos pendientes
+	// que la nombran la pierden en vez de quedar apuntando a memoria libre.
+	// Recorre solo los pendientes, que son pocos si la cola se vacia al
+	// terminar cada paso
+	void SayGoodbye(b2Joint* joint) override
+	{
+		if (nextDestruction)
+			nextDestruction->SayGoodbye(joint);
+	}
+
+	void SayGoodbye(b2Fixture* fixture) override
+	{
+		for (unsigned int i = head; i != tail; ++i)
+		{
+			ContactEvent& evt = events[i & mask];
+			if (evt.fixtureA == fixture)
+				evt.fixtureA = nullptr;
+			if (evt.fixtureB == fixture)
+				evt.fixtureB = nullptr;
+		}
+		if (nextDestruction)
+			nextDestruction->SayGoodbye(fixture);
+	}
+
+	// Procesa todos los eventos pendientes en orden y vacia la cola. El
+	// handler es una plantilla (por ejemplo una lambda), asi que se expande
+	// en linea sin llamada virtual por evento. Devuelve cuantos se procesaron
+	template <typename Handler>
+	int Drain(Handler handler)
+	{
+		int count = (int)(tail - head);
+		for (; head != tail; ++head)
+			handler(events[head & mask]);
+		return count;
+	}
+
+	// Descarta los eventos pendientes sin procesarlos
+	void Clear() { head = tail; }
+
+	int GetPendingCount() const { return (int)(tail - head); }
+	int GetCapacity() const { return (int)events.size(); }
+
+	// Eventos perdidos porque el buffer se lleno (conviene agrandarlo si no es cero)
+	int GetDroppedCount() const { return dropped; }
+};
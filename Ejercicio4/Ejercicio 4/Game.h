@@ -2,6 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactEventQueue.h"
+#include "MousePicker.h"
+#include "WorldSnapshot.h"
 #include <list>
 
 using namespace sf;
@@ -18,6 +21,17 @@ private:
 	b2World* phyWorld;
 	SFMLRenderer* debugRender;
 
+	// Eventos de contacto del ltimo paso, se procesan en CheckCollitions
+	ContactEventQueue contactEvents;
+	int contactCount;	// Pares tocndose ahora
+	int impactCount;	// Golpes fuertes desde el inicio
+
+	// Arrastrar cuerpos con el botn izquierdo
+	MousePicker picker;
+
+	// Estado inicial de los cuerpos, la R vuelve a l
+	WorldSnapshot initialState;
+
 	//tiempo de frame
 	float frameTime;
 	int fps;
@@ -33,6 +47,7 @@ public:
 	void CreateEnemy(int x, int y);
 	~Game(void);
 	void InitPhysics();
+	void ResetScene();
 
 	// Main game loop
 	void Loop();
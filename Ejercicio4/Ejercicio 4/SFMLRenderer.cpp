@@ -1,9 +1,9 @@
 #include "SFMLRenderer.h"
 
 // Constructor de la clase SFMLRenderer
-SFMLRenderer::SFMLRenderer(RenderWindow* window)
+SFMLRenderer::SFMLRenderer(RenderTarget* renderTarget)
 {
-    wnd = window; // Asigna el puntero a la ventana de renderizado
+    target = renderTarget; // Ventana o textura sobre la que se dibuja
 }
 
 // Destructor de la clase SFMLRenderer
@@ -21,7 +21,7 @@ void SFMLRenderer::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const
     for (int i = 0; i < vertexCount; ++i)
         polygon.setPoint(i, Vector2f(vertices[i].x, vertices[i].y)); // Establece los vrtices del polgono
 
-    wnd->draw(polygon); // Dibuja el polgono en la ventana
+    target->draw(polygon); // Dibuja el polgono en la ventana
 }
 
 // Dibuja un polgono con relleno
@@ -35,7 +35,7 @@ void SFMLRenderer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, c
     for (int i = 0; i < vertexCount; ++i)
         polygon.setPoint(i, Vector2f(vertices[i].x, vertices[i].y)); // Establece los vrtices del polgono
 
-    wnd->draw(polygon); // Dibuja el polgono en la ventana
+    target->draw(polygon); // Dibuja el polgono en la ventana
 }
 
 // Dibuja un crculo sin relleno
@@ -47,7 +47,7 @@ void SFMLRenderer::DrawCircle(const b2Vec2& center, float radius, const b2Color&
     circle.setFillColor(Color(0, 0, 0, 0)); // Sin relleno
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
-    wnd->draw(circle); // Dibuja el crculo en la ventana
+    target->draw(circle); // Dibuja el crculo en la ventana
 }
 
 // Dibuja un crculo con relleno
@@ -59,7 +59,7 @@ void SFMLRenderer::DrawSolidCircle(const b2Vec2& center, float radius, const b2V
     circle.setFillColor(box2d2SFMLColor(color)); // Establece el color de relleno
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
-    wnd->draw(circle); // Dibuja el crculo en la ventana
+    target->draw(circle); // Dibuja el crculo en la ventana
 }
 
 // Dibuja un segmento
@@ -71,7 +71,7 @@ void SFMLRenderer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color
         sf::Vertex(sf::Vector2f(p2.x, p2.y), box2d2SFMLColor(color))
     };
 
-    wnd->draw(line, 2, sf::Lines); // Dibuja el segmento en la ventana
+    target->draw(line, 2, sf::Lines); // Dibuja el segmento en la ventana
 }
 
 // Dibuja una transformacin
@@ -87,7 +87,7 @@ void SFMLRenderer::DrawTransform(const b2Transform& xf)
         sf::Vertex(sf::Vector2f(p1.x, p1.y), Color::Red),
         sf::Vertex(sf::Vector2f(p2.x, p2.y), Color::Green)
     };
-    wnd->draw(line, 2, sf::Lines);
+    target->draw(line, 2, sf::Lines);
 
     p2 = p1 + k_axisScale * xf.q.GetYAxis();
 
@@ -96,7 +96,7 @@ void SFMLRenderer::DrawTransform(const b2Transform& xf)
         sf::Vertex(sf::Vector2f(p1.x, p1.y), Color::Blue),
         sf::Vertex(sf::Vector2f(p2.x, p2.y), Color::Yellow)
     };
-    wnd->draw(line2, 2, sf::Lines);
+    target->draw(line2, 2, sf::Lines);
 }
 
 // Dibuja un punto
@@ -109,7 +109,7 @@ void SFMLRenderer::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
     circle.setFillColor(box2d2SFMLColor(color)); // Color del punto
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
-    wnd->draw(circle); // Dibuja el punto en la ventana
+    target->draw(circle); // Dibuja el punto en la ventana
 }
 
 // Dibuja un texto
@@ -120,7 +120,7 @@ void SFMLRenderer::DrawString(int x, int y, const char* string, ...)
     text.setString(string);
     text.setPosition(x, y);
 
-    wnd->draw(text); // Dibuja el texto en la ventana
+    target->draw(text); // Dibuja el texto en la ventana
 }
 
 // Dibuja un AABB (Axis-Aligned Bounding Box)
@@ -134,7 +134,7 @@ void SFMLRenderer::DrawAABB(b2AABB* aabb, const b2Color& color)
     rectangle.setFillColor(Color(0, 0, 0, 0)); // Sin relleno
     rectangle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
-    wnd->draw(rectangle); // Dibuja el AABB en la ventana
+    target->draw(rectangle); // Dibuja el AABB en la ventana
 }
 
 // Convierte un color de Box2D a un color de SFML
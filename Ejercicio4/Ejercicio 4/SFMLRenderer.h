@@ -1,6 +1,8 @@
 //-----------------------------------------------------
 //Clase utilitaria que provee los callbacks requeridos 
-//por SFML para dibujar los objetos que esta simulando
+//por SFML para dibujar los objetos que esta simulando.
+//Dibuja sobre una ventana o sobre una textura fuera de
+//pantalla (RenderTexture), por ejemplo para medir
 //-----------------------------------------------------
 
 #pragma once
@@ -12,10 +14,10 @@ using namespace sf;
 class SFMLRenderer : public b2Draw//b2DebugDraw
 {
 private:
-	RenderWindow* wnd;
+	RenderTarget* target;
 
 public:
-	SFMLRenderer(RenderWindow* window);
+	SFMLRenderer(RenderTarget* target);
 	~SFMLRenderer(void);
 
 	inline Color box2d2SFMLColor(const b2Color& _color);
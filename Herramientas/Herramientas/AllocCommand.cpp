@@ -0,0 +1,96 @@
+#include "Commands.h"
+#include "AllocationTracker.h"
+#include "ParticleSystem.h"
+#include "PhysicsCounters.h"
+#include "SceneAudit.h"
+#include "Scenes.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Corre una escena con el trabajo por frame de Act6 que no dibuja (paso,
+// auditora, contadores y partculas) y devuelve cuntos frames asignaron
+// memoria una vez pasado el calentamiento
+static long long CheckScene(SceneId id, int warmup, int frames)
+{
+    const float timeStep = 1.0f / 60.0f;
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    Scenes::Build(id, phyWorld);
+    SceneAudit audit;
+    PhysicsCounters counters;
+    ParticleSystem particles(10000);
+
+    // Un frame: cada uno tira una tanda de chispas para que el sistema de
+    // partculas llegue a un tamao estable durante el calentamiento
+    auto frame = [&]() {
+        {
+            HotSection hot("Step");
+            phyWorld->Step(timeStep, 8, 8);
+        }
+        phyWorld->ClearForces();
+        audit.Observe(phyWorld, timeStep);
+        counters.Sample(phyWorld, -1, 0.0f);
+        particles.SpawnBurst(b2Vec2(50.0f, 50.0f), 0.0f, 2.0f * b2_pi, 5.0f, 15.0f, 20, 0.5f, sf::Color::White);
+        particles.Update(timeStep, phyWorld->GetGravity());
+    };
+
+    AllocationTracker::ExpectZeroAllocations(false);
+    AllocationTracker::BeginFrame();
+    for (int i = 0; i < warmup; ++i)
+        frame();
+    FrameAllocations warm = AllocationTracker::EndFrame();
+
+    long long failedBefore = AllocationTracker::GetFailedFrames();
+    AllocationTracker::ExpectZeroAllocations(true);
+    for (int i = 0; i < frames; ++i)
+    {
+        AllocationTracker::BeginFrame();
+        frame();
+        AllocationTracker::EndFrame();
+    }
+    AllocationTracker::ExpectZeroAllocations(false);
+    long long failed = AllocationTracker::GetFailedFrames() - failedBefore;
+
+    std::printf("%-11s calentamiento: %lld asignaciones, %lld bytes; %d frames despues: %lld con asignaciones\n",
+        Scenes::GetName(id), warm.GetAllocations(), warm.GetBytes(), frames, failed);
+    delete phyWorld;
+    return failed;
+}
+
+// asignaciones [escena|todas] [--calentamiento N] [--frames N]
+// Chequeo de cero asignaciones por frame estable. Sale con 1 si algn
+// frame despus del calentamiento pidi memoria. Las de Box2D solo se ven
+// si se compil con b2_user_settings.h
+int RunAllocCommand(int argc, char* argv[])
+{
+    const char* sceneName = "todas";
+    int warmup = 300;
+    int frames = 600;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--calentamiento") == 0 && i + 1 < argc)
+            warmup = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frames = std::atoi(argv[++i]);
+        else
+            sceneName = argv[i];
+    }
+
+    long long failed = 0;
+    if (std::strcmp(sceneName, "todas") == 0)
+    {
+        for (int id = 0; id < Scene_Count; ++id)
+            failed += CheckScene((SceneId)id, warmup, frames);
+    }
+    else
+    {
+        SceneId id;
+        if (!Scenes::FromName(sceneName, id))
+        {
+            std::printf("Escena desconocida: %s\n", sceneName);
+            return 2;
+        }
+        failed += CheckScene(id, warmup, frames);
+    }
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#include "Commands.h"
+#include "SceneAudit.h"
+#include "Scenes.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Audita una escena: la arma, la simula unos pasos observando los cuerpos
+// y devuelve la cantidad de hallazgos que hacen fallar el chequeo
+static int AuditScene(SceneId id, int steps, AuditSeverity failSeverity)
+{
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    Scenes::Build(id, phyWorld);
+
+    const float timeStep = 1.0f / 60.0f;
+    SceneAudit audit;
+    audit.Observe(phyWorld, timeStep);
+    for (int i = 0; i < steps; ++i)
+    {
+        phyWorld->Step(timeStep, 8, 8);
+        phyWorld->ClearForces();
+        audit.Observe(phyWorld, timeStep);
+    }
+
+    std::vector<AuditFinding> findings = audit.Run(phyWorld);
+    std::cout << "== " << Scenes::GetName(id) << " (" << steps << " pasos)\n";
+    SceneAudit::Print(findings, std::cout);
+
+    delete phyWorld;
+    return SceneAudit::CountAtLeast(findings, failSeverity);
+}
+
+// auditar [escena|todas] [--pasos N] [--estricto]
+// Sale con 1 si alguna escena tiene avisos o errores (o cualquier hallazgo
+// con --estricto), para poder usarlo como chequeo de CI
+int RunAuditCommand(int argc, char* argv[])
+{
+    const char* sceneName = "todas";
+    int steps = 300;
+    AuditSeverity failSeverity = Severity_Warning;
+
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--estricto") == 0)
+            failSeverity = Severity_Info;
+        else
+            sceneName = argv[i];
+    }
+
+    int failures = 0;
+    if (std::strcmp(sceneName, "todas") == 0)
+    {
+        for (int id = 0; id < Scene_Count; ++id)
+            failures += AuditScene((SceneId)id, steps, failSeverity);
+    }
+    else
+    {
+        SceneId id;
+        if (!Scenes::FromName(sceneName, id))
+        {
+            std::cout << "Escena desconocida: " << sceneName << "\n";
+            return 2;
+        }
+        failures += AuditScene(id, steps, failSeverity);
+    }
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+#include "Commands.h"
+#include "BatchSimulator.h"
+#include "Scenes.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// lote [--mundos N] [--pasos N] [--hilos N]
+// El bloque de Act5 sobre el plano a 45 grados con la friccion del bloque
+// barrida de 0 a 1, un mundo por valor. Se corre primero en un solo hilo
+// y despues en el pool, para ver cuanto escala
+int RunBatchCommand(int argc, char* argv[])
+{
+    int worlds = 2000;
+    int steps = 600;
+    int threads = 0;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--mundos") == 0 && i + 1 < argc)
+            worlds = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--hilos") == 0 && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+    }
+    if (worlds < 1)
+        worlds = 1;
+
+    // Cada trabajo arma su propia copia de la escena; solo lee worlds
+    BatchSetup setup = [worlds](b2World* phyWorld, int job) {
+        b2Body* block = Scenes::BuildAct5(phyWorld);
+        float friction = worlds > 1 ? (float)job / (worlds - 1) : 0.5f;
+        block->GetFixtureList()->SetFriction(friction);
+        return block;
+    };
+    const float timeStep = 1.0f / 60.0f;
+
+    BatchSimulator serial(nullptr);
+    auto start = std::chrono::steady_clock::now();
+    serial.Run(worlds, setup, steps, timeStep, true);
+    double serialMs = ElapsedMs(start);
+
+    ThreadPool pool(threads > 0 ? threads - 1 : -1);
+    BatchSimulator parallel(&pool);
+    start = std::chrono::steady_clock::now();
+    parallel.Run(worlds, setup, steps, timeStep, true);
+    double parallelMs = ElapsedMs(start);
+
+    // Algunas filas de la tabla: cuanto se deslizo el bloque y cuando paro
+    std::printf("friccion  desplazamiento  se durmio\n");
+    int rows = worlds < 11 ? worlds : 11;
+    for (int r = 0; r < rows; ++r)
+    {
+        int job = rows > 1 ? r * (worlds - 1) / (rows - 1) : 0;
+        const BatchResult& result = parallel.GetResult(job);
+        float friction = worlds > 1 ? (float)job / (worlds - 1) : 0.5f;
+        float distance = (result.endPosition - result.startPosition).Length();
+        std::printf("%8.3f  %12.2f m  %7.2f s\n", friction, distance, result.sleepTime);
+    }
+
+    // Los dos lotes tienen que dar lo mismo: cada mundo es independiente
+    int mismatches = 0;
+    for (int job = 0; job < worlds; ++job)
+    {
+        const BatchResult& a = serial.GetResult(job);
+        const BatchResult& b = parallel.GetResult(job);
+        if (a.steps != b.steps || a.endPosition.x != b.endPosition.x || a.endPosition.y != b.endPosition.y)
+            mismatches++;
+    }
+
+    double speedup = serialMs / parallelMs;
+    std::printf("%d mundos, hasta %d pasos\n", worlds, steps);
+    std::printf("1 hilo:   %9.2f ms  %9.1f mundos/s\n", serialMs, worlds * 1000.0 / serialMs);
+    std::printf("%d hilos: %9.2f ms  %9.1f mundos/s  aceleracion %.2fx (%.0f%% por hilo)\n", pool.GetThreadCount(), parallelMs,
+        worlds * 1000.0 / parallelMs, speedup, 100.0 * speedup / pool.GetThreadCount());
+    if (mismatches > 0)
+        std::printf("%d mundos dieron distinto en paralelo\n", mismatches);
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+#include "Commands.h"
+#include "Benchmark.h"
+#include "Box2DHelper.h"
+#include "SFMLRenderer.h"
+#include "Scenes.h"
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Polgonos de prueba: un cuadrado convexo y una L cncava (se descompone
+// en dos piezas; la descomposicin queda en cache despus de la primera)
+static b2Vec2 square[4] = { b2Vec2(-1.0f, -1.0f), b2Vec2(1.0f, -1.0f), b2Vec2(1.0f, 1.0f), b2Vec2(-1.0f, 1.0f) };
+static b2Vec2 lShape[6] = { b2Vec2(0.0f, 0.0f), b2Vec2(4.0f, 0.0f), b2Vec2(4.0f, 1.0f), b2Vec2(1.0f, 1.0f), b2Vec2(1.0f, 4.0f), b2Vec2(0.0f, 4.0f) };
+
+// Una fbrica de cuerpos: cada iteracin crea uno en un mundo nuevo por
+// muestra. Crear y borrar el mundo no cuenta
+static void BenchBody(BenchmarkRunner& runner, const char* name, const std::function<b2Body*(b2World*)>& create)
+{
+    runner.Run(std::string("helper/") + name, "llamada", [&create](BenchmarkTimer& timer, int iterations) {
+        timer.Pause();
+        b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+        timer.Resume();
+        for (int i = 0; i < iterations; ++i)
+            create(phyWorld);
+        timer.Pause();
+        delete phyWorld;
+        timer.Resume();
+    });
+}
+
+// Una fbrica de b2FixtureDef. La forma que devuelve queda a cargo del que
+// llama: se borra en cada iteracin y eso entra en la medicin
+static void BenchFixtureDef(BenchmarkRunner& runner, const char* name, const std::function<b2FixtureDef()>& create)
+{
+    runner.Run(std::string("helper/") + name, "llamada", [&create](BenchmarkTimer& timer, int iterations) {
+        for (int i = 0; i < iterations; ++i)
+        {
+            b2FixtureDef fixtureDef = create();
+            delete fixtureDef.shape;
+        }
+    });
+}
+
+void RunHelperBenchmarks(BenchmarkRunner& runner)
+{
+    BenchBody(runner, "CreateDynamicBody", [](b2World* w) { return Box2DHelper::CreateDynamicBody(w); });
+    BenchBody(runner, "CreateStaticBody", [](b2World* w) { return Box2DHelper::CreateStaticBody(w); });
+    BenchBody(runner, "CreateKinematicBody", [](b2World* w) { return Box2DHelper::CreateKinematicBody(w); });
+
+    BenchFixtureDef(runner, "CreateRectangularFixtureDef", [] { return Box2DHelper::CreateRectangularFixtureDef(2.0f, 2.0f, 1.0f, 0.5f, 0.1f); });
+    BenchFixtureDef(runner, "CreateCircularFixtureDef", [] { return Box2DHelper::CreateCircularFixtureDef(1.0f, 1.0f, 0.5f, 0.1f); });
+    BenchFixtureDef(runner, "CreatePolyFixtureDef", [] { return Box2DHelper::CreatePolyFixtureDef(square, 4, 1.0f, 0.5f, 0.1f); });
+    BenchFixtureDef(runner, "CreateTriangularFixtureDef", [] { return Box2DHelper::CreateTriangularFixtureDef(b2Vec2(0.0f, 0.0f), 2.0f, 1.0f, 0.5f, 0.1f); });
+    BenchBody(runner, "CreatePolyFixtures", [](b2World* w) {
+        b2Body* body = Box2DHelper::CreateDynamicBody(w);
+        Box2DHelper::CreatePolyFixtures(body, lShape, 6, 1.0f, 0.5f, 0.1f);
+        return body;
+    });
+
+    BenchBody(runner, "CreateRectangularDynamicBody", [](b2World* w) { return Box2DHelper::CreateRectangularDynamicBody(w, 2.0f, 2.0f, 1.0f, 0.5f, 0.1f); });
+    BenchBody(runner, "CreateRectangularKinematicBody", [](b2World* w) { return Box2DHelper::CreateRectangularKinematicBody(w, 2.0f, 2.0f); });
+    BenchBody(runner, "CreateRectangularStaticBody", [](b2World* w) { return Box2DHelper::CreateRectangularStaticBody(w, 2.0f, 2.0f); });
+    BenchBody(runner, "CreateCircularDynamicBody", [](b2World* w) { return Box2DHelper::CreateCircularDynamicBody(w, 1.0f, 1.0f, 0.5f, 0.1f); });
+    BenchBody(runner, "CreateCircularKinematicBody", [](b2World* w) { return Box2DHelper::CreateCircularKinematicBody(w, 1.0f); });
+    BenchBody(runner, "CreateCircularStaticBody", [](b2World* w) { return Box2DHelper::CreateCircularStaticBody(w, 1.0f); });
+    BenchBody(runner, "CreateTriangularDynamicBody", [](b2World* w) { return Box2DHelper::CreateTriangularDynamicBody(w, b2Vec2(0.0f, 0.0f), 2.0f, 1.0f, 0.5f, 0.1f); });
+    BenchBody(runner, "CreateTriangularKinematicBody", [](b2World* w) { return Box2DHelper::CreateTriangularKinematicBody(w, b2Vec2(0.0f, 0.0f), 2.0f); });
+    BenchBody(runner, "CreateTriangularStaticBody", [](b2World* w) { return Box2DHelper::CreateTriangularStaticBody(w, b2Vec2(0.0f, 0.0f), 2.0f); });
+    BenchBody(runner, "CreatePolyDynamicBody", [](b2World* w) { return Box2DHelper::CreatePolyDynamicBody(w, lShape, 6, 1.0f, 0.5f, 0.1f); });
+    BenchBody(runner, "CreatePolyKinematicBody", [](b2World* w) { return Box2DHelper::CreatePolyKinematicBody(w, lShape, 6); });
+    BenchBody(runner, "CreatePolyStaticBody", [](b2World* w) { return Box2DHelper::CreatePolyStaticBody(w, lShape, 6); });
+}
+
+// Una primitiva del renderer dibujada iterations veces sobre la textura.
+// El display() del final entra en la medicin: obliga a mandar todo al driver
+static void BenchPrimitive(BenchmarkRunner& runner, RenderTexture& texture, const char* name, const std::function<void()>& draw)
+{
+    runner.Run(std::string("renderer/") + name, "llamada", [&texture, &draw](BenchmarkTimer& timer, int iterations) {
+        timer.Pause();
+        texture.clear();
+        timer.Resume();
+        for (int i = 0; i < iterations; ++i)
+            draw();
+        texture.display();
+    });
+}
+
+void RunRendererBenchmarks(BenchmarkRunner& runner)
+{
+    if (!runner.Matches("renderer/"))
+        return;
+
+    // Fuera de pantalla: mismo camino de dibujo que la ventana, sin ventana
+    RenderTexture texture;
+    if (!texture.create(512, 512))
+    {
+        std::printf("renderer: no se pudo crear la textura fuera de pantalla, se saltea\n");
+        return;
+    }
+    View camara;
+    camara.setSize(100.0f, 100.0f);
+    camara.setCenter(50.0f, 50.0f);
+    texture.setView(camara);
+    SFMLRenderer renderer(&texture);
+
+    b2Vec2 box[4] = { b2Vec2(40.0f, 40.0f), b2Vec2(60.0f, 40.0f), b2Vec2(60.0f, 60.0f), b2Vec2(40.0f, 60.0f) };
+    b2Color color(0.9f, 0.7f, 0.7f);
+    b2Vec2 center(50.0f, 50.0f);
+    b2Transform xf(center, b2Rot(0.3f));
+    b2AABB aabb;
+    aabb.lowerBound.Set(30.0f, 30.0f);
+    aabb.upperBound.Set(70.0f, 70.0f);
+
+    BenchPrimitive(runner, texture, "DrawPolygon", [&] { renderer.DrawPolygon(box, 4, color); });
+    BenchPrimitive(runner, texture, "DrawSolidPolygon", [&] { renderer.DrawSolidPolygon(box, 4, color); });
+    BenchPrimitive(runner, texture, "DrawCircle", [&] { renderer.DrawCircle(center, 10.0f, color); });
+    BenchPrimitive(runner, texture, "DrawSolidCircle", [&] { renderer.DrawSolidCircle(center, 10.0f, b2Vec2(1.0f, 0.0f), color); });
+    BenchPrimitive(runner, texture, "DrawSegment", [&] { renderer.DrawSegment(box[0], box[2], color); });
+    BenchPrimitive(runner, texture, "DrawTransform", [&] { renderer.DrawTransform(xf); });
+    BenchPrimitive(runner, texture, "DrawPoint", [&] { renderer.DrawPoint(center, 2.0f, color); });
+    BenchPrimitive(runner, texture, "DrawString", [&] { renderer.DrawString(10, 10, "texto"); });
+    BenchPrimitive(runner, texture, "DrawAABB", [&] { renderer.DrawAABB(&aabb, color); });
+
+    // El dibujo de depuracin de una escena entera, con todas las banderas
+    renderer.SetFlags(UINT_MAX);
+    for (int id = 0; id < Scene_Count; ++id)
+    {
+        b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+        Scenes::Build((SceneId)id, phyWorld);
+        phyWorld->SetDebugDraw(&renderer);
+        BenchPrimitive(runner, texture, (std::string("DebugDraw/") + Scenes::GetName((SceneId)id)).c_str(), [phyWorld] { phyWorld->DebugDraw(); });
+        delete phyWorld;
+    }
+}
+
+// Arma copies copias de la escena en una grilla, a 150 m una de otra para
+// que no se toquen. Box2D agrega cada cuerpo al principio de la lista: los
+// de la copia recin armada son los que estn antes de la cabeza anterior
+static void BuildSceneCopies(SceneId id, b2World* phyWorld, int copies)
+{
+    int columns = (int)std::ceil(std::sqrt((float)copies));
+    for (int c = 0; c < copies; ++c)
+    {
+        b2Body* previous = phyWorld->GetBodyList();
+        Scenes::Build(id, phyWorld);
+        b2Vec2 offset(150.0f * (c % columns), 150.0f * (c / columns));
+        for (b2Body* body = phyWorld->GetBodyList(); body != previous; body = body->GetNext())
+            body->SetTransform(body->GetPosition() + offset, body->GetAngle());
+    }
+}
+
+void RunSceneBenchmarks(BenchmarkRunner& runner, int scale, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    for (int id = 0; id < Scene_Count; ++id)
+    {
+        // Tamao original y escalado. Cada muestra simula los mismos pasos
+        // desde el armado, as todas recorren el mismo tramo de la escena
+        int sizes[2] = { 1, scale };
+        for (int s = 0; s < (scale > 1 ? 2 : 1); ++s)
+        {
+            int copies = sizes[s];
+            char name[64];
+            std::snprintf(name, sizeof(name), "escena/%s/x%d", Scenes::GetName((SceneId)id), copies);
+            runner.Run(name, "paso", [id, copies, timeStep](BenchmarkTimer& timer, int iterations) {
+                timer.Pause();
+                b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+                BuildSceneCopies((SceneId)id, phyWorld, copies);
+                timer.Resume();
+                for (int i = 0; i < iterations; ++i)
+                    phyWorld->Step(timeStep, 8, 8);
+                timer.Pause();
+                delete phyWorld;
+                timer.Resume();
+            }, steps);
+        }
+    }
+}
+
+// rendimiento [--filtro texto] [--muestras N] [--escala N] [--pasos N] [--salida archivo]
+// Microbenchmarks de cada fbrica de Box2DHelper y de cada primitiva de
+// SFMLRenderer (sobre una textura fuera de pantalla) y macrobenchmarks
+// del paso de cada escena, en su tamao y con N copias. Escribe un JSON
+// con nombres estables para comparar corridas
+int RunBenchCommand(int argc, char* argv[])
+{
+    std::string filter;
+    int samples = 10;
+    int scale = 64;
+    int steps = 600;
+    const char* outputPath = "rendimiento.json";
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--filtro") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (std::strcmp(argv[i], "--muestras") == 0 && i + 1 < argc)
+            samples = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--escala") == 0 && i + 1 < argc)
+            scale = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--salida") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+    }
+    if (steps < 1)
+        steps = 1;
+
+    BenchmarkRunner runner(filter, samples);
+    RunHelperBenchmarks(runner);
+    RunRendererBenchmarks(runner);
+    RunSceneBenchmarks(runner, scale, steps);
+
+    if (!runner.WriteJson(outputPath))
+    {
+        std::printf("No se pudo escribir %s\n", outputPath);
+        return 1;
+    }
+    std::printf("%d mediciones en %s\n", (int)runner.GetResults().size(), outputPath);
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+double BenchmarkResult::GetMin() const
+{
+    return samples.empty() ? 0.0 : *std::min_element(samples.begin(), samples.end());
+}
+
+double BenchmarkResult::GetMedian() const
+{
+    if (samples.empty())
+        return 0.0;
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    size_t middle = sorted.size() / 2;
+    return sorted.size() % 2 ? sorted[middle] : 0.5 * (sorted[middle - 1] + sorted[middle]);
+}
+
+double BenchmarkResult::GetMad() const
+{
+    double median = GetMedian();
+    BenchmarkResult deviations;
+    for (double sample : samples)
+        deviations.samples.push_back(std::fabs(sample - median));
+    return deviations.GetMedian();
+}
+
+double BenchmarkResult::GetMean() const
+{
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += sample;
+    return samples.empty() ? 0.0 : sum / samples.size();
+}
+
+// Constructor de la clase BenchmarkRunner
+BenchmarkRunner::BenchmarkRunner(const std::string& nameFilter, int samples, double sampleMs)
+{
+    filter = nameFilter;
+    sampleCount = samples > 0 ? samples : 1;
+    minSampleMs = sampleMs;
+}
+
+bool BenchmarkRunner::Matches(const std::string& name) const
+{
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+void BenchmarkRunner::Run(const std::string& name, const char* unit, const BenchmarkBody& body, int iterations)
+{
+    if (!Matches(name))
+        return;
+
+    // Una muestra: el cuerpo arranca con el reloj andando
+    auto sample = [&body](int count) {
+        BenchmarkTimer timer;
+        timer.Resume();
+        body(timer, count);
+        timer.Pause();
+        return timer.GetElapsedNs();
+    };
+
+    // Calibrar: duplicar las iteraciones hasta que una muestra dure lo
+    // pedido. Sirve adems de calentamiento
+    if (iterations <= 0)
+    {
+        iterations = 1;
+        while (sample(iterations) < minSampleMs * 1.0e6 && iterations < (1 << 24))
+            iterations *= 2;
+    }
+    else
+        sample(iterations);
+
+    BenchmarkResult result;
+    result.name = name;
+    result.unit = unit;
+    result.iterations = iterations;
+    for (int s = 0; s < sampleCount; ++s)
+        result.samples.push_back(sample(iterations) / iterations);
+
+    std::printf("%-48s %12.1f ns/%s  (min %.1f, %d x %d)\n", name.c_str(), result.GetMedian(), unit,
+        result.GetMin(), sampleCount, iterations);
+    results.push_back(result);
+}
+
+// Escribe el texto entre comillas escapando lo que JSON no acepta suelto
+static void WriteJsonString(FILE* file, const std::string& text)
+{
+    std::fputc('"', file);
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            std::fprintf(file, "\\%c", c);
+        else if ((unsigned char)c < 0x20)
+            std::fprintf(file, "\\u%04x", c);
+        else
+            std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+bool BenchmarkRunner::WriteJson(const char* path) const
+{
+    FILE* file = std::fopen(path, "w");
+    if (!file)
+        return false;
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+    const char* build = "release";
+#else
+    const char* build = "debug";
+#endif
+
+    std::fprintf(file, "{\n  \"formato\": 1,\n  \"fecha\": \"%s\",\n  \"compilacion\": \"%s\",\n  \"resultados\": [\n", date, build);
+    for (size_t r = 0; r < results.size(); ++r)
+    {
+        const BenchmarkResult& result = results[r];
+        std::fprintf(file, "    { \"nombre\": ");
+        WriteJsonString(file, result.name);
+        std::fprintf(file, ", \"unidad\": ");
+        WriteJsonString(file, result.unit);
+        std::fprintf(file, ", \"iteraciones\": %d, \"mediana_ns\": %.3f, \"minimo_ns\": %.3f, \"media_ns\": %.3f, \"muestras_ns\": [",
+            result.iterations, result.GetMedian(), result.GetMin(), result.GetMean());
+        for (size_t s = 0; s < result.samples.size(); ++s)
+            std::fprintf(file, "%s%.3f", s > 0 ? ", " : "", result.samples[s]);
+        std::fprintf(file, "] }%s\n", r + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+// Busca "clave": a partir de from y devuelve la posicin del valor, o npos
+static size_t FindValue(const std::string& text, const char* key, size_t from, size_t end)
+{
+    std::string quoted = std::string("\"") + key + "\":";
+    size_t at = text.find(quoted, from);
+    if (at == std::string::npos || at >= end)
+        return std::string::npos;
+    at += quoted.size();
+    while (at < end && std::isspace((unsigned char)text[at]))
+        at++;
+    return at;
+}
+
+// Texto entre comillas a partir de at (sin escapes: los nombres no los usan)
+static std::string ReadString(const std::string& text, size_t at)
+{
+    if (at == std::string::npos || text[at] != '"')
+        return "";
+    size_t close = text.find('"', at + 1);
+    return close == std::string::npos ? "" : text.substr(at + 1, close - at - 1);
+}
+
+bool BenchmarkRunner::ReadJson(const char* path, std::vector<BenchmarkResult>& out, std::string& error)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file)
+    {
+        error = std::string("no se pudo abrir ") + path;
+        return false;
+    }
+    std::string text;
+    char buffer[65536];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        text.append(buffer, read);
+    std::fclose(file);
+
+    if (FindValue(text, "formato", 0, text.size()) == std::string::npos || text.find("\"resultados\"") == std::string::npos)
+    {
+        error = std::string(path) + " no es una salida de rendimiento";
+        return false;
+    }
+
+    // Un resultado por cada "nombre", hasta el prximo
+    out.clear();
+    size_t at = FindValue(text, "nombre", 0, text.size());
+    while (at != std::string::npos)
+    {
+        size_t next = FindValue(text, "nombre", at, text.size());
+        size_t end = next == std::string::npos ? text.size() : next;
+
+        BenchmarkResult result;
+        result.name = ReadString(text, at);
+        result.unit = ReadString(text, FindValue(text, "unidad", at, end));
+        size_t iterations = FindValue(text, "iteraciones", at, end);
+        result.iterations = iterations == std::string::npos ? 0 : std::atoi(text.c_str() + iterations);
+
+        size_t samples = FindValue(text, "muestras_ns", at, end);
+        if (result.name.empty() || samples == std::string::npos || text[samples] != '[')
+        {
+            error = std::string(path) + ": resultado incompleto cerca de \"" + result.name + "\"";
+            return false;
+        }
+        const char* cursor = text.c_str() + samples + 1;
+        for (;;)
+        {
+            while (std::isspace((unsigned char)*cursor) || *cursor == ',')
+                cursor++;
+            if (*cursor == ']' || *cursor == 0)
+                break;
+            char* parsed;
+            double value = std::strtod(cursor, &parsed);
+            if (parsed == cursor)
+            {
+                error = std::string(path) + ": muestra invalida en \"" + result.name + "\"";
+                return false;
+            }
+            result.samples.push_back(value);
+            cursor = parsed;
+        }
+        out.push_back(result);
+        at = next;
+    }
+    return true;
+}
+
+bool PinCurrentThread(int core)
+{
+#ifdef _WIN32
+    // La mascara tiene un bit por nucleo: 32 en un build de 32 bits
+    if (core < 0 || core >= (int)(sizeof(DWORD_PTR) * 8))
+        return false;
+    if (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core) == 0)
+        return false;
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    return true;
+#else
+    if (core < 0 || core >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        return false;
+    // En Linux el nice de PRIO_PROCESS 0 es el del hilo que llama. Bajarlo
+    // pide permisos: sin ellos queda fijo al nucleo con la prioridad normal
+    setpriority(PRIO_PROCESS, 0, -10);
+    return true;
+#endif
+}
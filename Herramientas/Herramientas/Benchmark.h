@@ -0,0 +1,99 @@
+//-----------------------------------------------------
+//Mediciones de rendimiento con salida en JSON. Cada
+//medicion tiene un nombre estable ("grupo/caso") para
+//poder comparar corridas; se repite en varias muestras
+//y de cada una se guarda el tiempo por iteracion
+//-----------------------------------------------------
+
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Reloj de una muestra. El cuerpo de la medicion puede pausarlo para que
+// el armado y la limpieza no cuenten
+class BenchmarkTimer
+{
+private:
+	std::chrono::steady_clock::time_point start;
+	double elapsedNs;
+	bool running;
+
+public:
+	BenchmarkTimer() : elapsedNs(0.0), running(false) {}
+
+	void Resume()
+	{
+		if (running)
+			return;
+		running = true;
+		start = std::chrono::steady_clock::now();
+	}
+
+	void Pause()
+	{
+		if (!running)
+			return;
+		running = false;
+		elapsedNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	double GetElapsedNs() const { return elapsedNs; }
+};
+
+struct BenchmarkResult
+{
+	std::string name;
+	std::string unit;				// Que es una iteracion ("llamada", "paso", ...)
+	int iterations;					// Iteraciones por muestra
+	std::vector<double> samples;	// Nanosegundos por iteracion de cada muestra
+
+	double GetMin() const;
+	double GetMedian() const;
+	double GetMean() const;
+
+	// Desviacin absoluta mediana: la mediana de |muestra - mediana|. Mide
+	// el ruido sin que un par de muestras lentas (el sistema hizo otra
+	// cosa) la agranden como a la desviacin estndar
+	double GetMad() const;
+};
+
+// Corre la medicion iterations veces con el reloj andando
+typedef std::function<void(BenchmarkTimer& timer, int iterations)> BenchmarkBody;
+
+class BenchmarkRunner
+{
+private:
+	std::string filter;		// Solo corren los nombres que lo contienen
+	int sampleCount;
+	double minSampleMs;
+	std::vector<BenchmarkResult> results;
+
+public:
+	BenchmarkRunner(const std::string& filter, int sampleCount = 10, double minSampleMs = 20.0);
+
+	bool Matches(const std::string& name) const;
+
+	// Mide body si el nombre pasa el filtro. Con iterations 0 se calibra
+	// para que cada muestra dure al menos minSampleMs; con un valor fijo
+	// todas las muestras hacen el mismo trabajo (por ejemplo N pasos
+	// desde el armado de la escena)
+	void Run(const std::string& name, const char* unit, const BenchmarkBody& body, int iterations = 0);
+
+	const std::vector<BenchmarkResult>& GetResults() const { return results; }
+	bool WriteJson(const char* path) const;
+
+	// Lee un archivo escrito por WriteJson (no es un lector de JSON general)
+	static bool ReadJson(const char* path, std::vector<BenchmarkResult>& results, std::string& error);
+};
+
+// Fija el hilo actual a un ncleo y le sube la prioridad si el sistema lo
+// permite, para que no lo mueva de ncleo entre muestras. Devuelve false
+// si no pudo fijarlo (la prioridad es un extra: si falla no cuenta)
+bool PinCurrentThread(int core);
+
+// Conjuntos de mediciones de "rendimiento"
+void RunHelperBenchmarks(BenchmarkRunner& runner);
+void RunRendererBenchmarks(BenchmarkRunner& runner);
+void RunSceneBenchmarks(BenchmarkRunner& runner, int scale, int steps);
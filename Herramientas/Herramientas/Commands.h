@@ -0,0 +1,56 @@
+//-----------------------------------------------------
+//Comandos de la herramienta de linea de comandos.
+//Cada comando recibe los argumentos que siguen a su
+//nombre y devuelve el codigo de salida del proceso
+//-----------------------------------------------------
+
+#pragma once
+
+// auditar [escena|todas] [--pasos N] [--estricto]
+int RunAuditCommand(int argc, char* argv[]);
+
+// filtros [--pasos N]
+int RunFilterCommand(int argc, char* argv[]);
+
+// consultas [--cuerpos N] [--consultas N] [--semilla N] [--repeticiones N]
+int RunQueryCommand(int argc, char* argv[]);
+
+// compilar <texto> <binario>
+int RunCompileCommand(int argc, char* argv[]);
+
+// arranque [--cuerpos N]
+int RunStartupCommand(int argc, char* argv[]);
+
+// mapeo [--fixtures N]
+int RunMappedStartupCommand(int argc, char* argv[]);
+
+// recarga [--cuerpos N]
+int RunReloadCommand(int argc, char* argv[]);
+
+// estres <tipo|todas> [--cuerpos N] [--semilla N] [--pasos N] [--escala]
+int RunStressCommand(int argc, char* argv[]);
+
+// lote [--mundos N] [--pasos N] [--hilos N]
+int RunBatchCommand(int argc, char* argv[]);
+
+// barrido <escena> [--restitucion a:b:n] [--friccion a:b:n] [--densidad a:b:n]
+//         [--gravedad a:b:n] [--pasos N] [--hilos N] [--salida archivo] [--continuar]
+int RunSweepCommand(int argc, char* argv[]);
+
+// tareas [--hilos N] [--tareas N] [--rayos N]
+int RunJobCommand(int argc, char* argv[]);
+
+// particulas [--cantidad N] [--frames N]
+int RunParticleCommand(int argc, char* argv[]);
+
+// rendimiento [--filtro texto] [--muestras N] [--escala N] [--pasos N] [--salida archivo]
+int RunBenchCommand(int argc, char* argv[]);
+
+// regresion [--muestras N] [--escala N] [--pasos N] [--nucleo N] [--salida archivo]
+int RunRegressionCommand(int argc, char* argv[]);
+
+// comparar <base> <nuevo> [--umbral P] [--umbral-para prefijo=P] [--ruido K]
+int RunCompareCommand(int argc, char* argv[]);
+
+// asignaciones [escena|todas] [--calentamiento N] [--frames N]
+int RunAllocCommand(int argc, char* argv[]);
@@ -0,0 +1,102 @@
+#include "Commands.h"
+#include "Box2DHelper.h"
+#include "CollisionLayers.h"
+#include "Scenes.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Resultado de una corrida con muchas balas
+struct FilterRunStats
+{
+    int bullets;
+    int finalContacts;
+    float avgContacts;
+    float avgCollideMs;		// b2Profile::collide: actualizacion de contactos (narrowphase)
+    float avgStepMs;
+};
+
+// Simula la escena de Act6 disparando una bala cada dos pasos hacia la
+// esquina inferior derecha, donde se apilan, y mide contactos y tiempos
+static FilterRunStats RunBulletStorm(int steps)
+{
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    b2Body* cannon = Scenes::BuildAct6(phyWorld);
+
+    const float timeStep = 1.0f / 60.0f;
+    b2Vec2 cannonPos = cannon->GetPosition();
+    float angle = std::atan2(95.0f - cannonPos.y, 95.0f - cannonPos.x);
+    cannon->SetTransform(cannonPos, angle);
+    b2Vec2 dir(std::cos(angle), std::sin(angle));
+
+    FilterRunStats stats = {};
+    double contactSum = 0.0;
+    double collideSum = 0.0;
+    double stepSum = 0.0;
+
+    for (int i = 0; i < steps; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            // Mismo disparo que Game::Shoot
+            b2Body* bullet = Box2DHelper::CreateCircularDynamicBody(phyWorld, 0.5f, 1.0f, 0.2f, 0.1f);
+            bullet->SetTransform(cannonPos + 7.5f * dir, angle);
+            CollisionLayers::Apply(bullet, Layer_Projectile);
+            bullet->SetLinearVelocity(50.0f * dir);
+            stats.bullets++;
+        }
+
+        phyWorld->Step(timeStep, 8, 8);
+        phyWorld->ClearForces();
+
+        const b2Profile& profile = phyWorld->GetProfile();
+        contactSum += phyWorld->GetContactCount();
+        collideSum += profile.collide;
+        stepSum += profile.step;
+    }
+
+    stats.finalContacts = phyWorld->GetContactCount();
+    stats.avgContacts = (float)(contactSum / steps);
+    stats.avgCollideMs = (float)(collideSum / steps);
+    stats.avgStepMs = (float)(stepSum / steps);
+
+    delete phyWorld;
+    return stats;
+}
+
+static void PrintStats(const char* label, const FilterRunStats& stats)
+{
+    std::printf("%-12s balas %5d  contactos prom %9.1f  final %7d  narrowphase %7.3f ms/paso  paso %7.3f ms\n",
+        label, stats.bullets, stats.avgContacts, stats.finalContacts, stats.avgCollideMs, stats.avgStepMs);
+}
+
+// filtros [--pasos N]
+// Compara la corrida sin filtros contra las capas por defecto
+int RunFilterCommand(int argc, char* argv[])
+{
+    int steps = 1200;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+    }
+    if (steps < 1)
+        steps = 1;
+
+    // Las fabricas toman la mascara al crear las fixtures, por eso la
+    // tabla se elige antes de armar cada mundo
+    CollisionLayers::SetAllCollide();
+    FilterRunStats before = RunBulletStorm(steps);
+
+    CollisionLayers::ResetDefaults();
+    FilterRunStats after = RunBulletStorm(steps);
+
+    PrintStats("sin filtros", before);
+    PrintStats("con capas", after);
+    if (before.avgCollideMs > 0.0f)
+        std::printf("narrowphase: %.1f%% del tiempo original\n", 100.0f * after.avgCollideMs / before.avgCollideMs);
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "Commands.h" // Declaraciones de los comandos disponibles
+#include <cstring>
+#include <iostream>
+
+// Entrada de la tabla de comandos
+struct Command
+{
+    const char* name;
+    int (*run)(int argc, char* argv[]);
+    const char* usage;
+};
+
+static const Command commands[] = {
+    { "auditar", RunAuditCommand, "auditar [escena|todas] [--pasos N] [--estricto]" },
+    { "filtros", RunFilterCommand, "filtros [--pasos N]" },
+    { "consultas", RunQueryCommand, "consultas [--cuerpos N] [--consultas N] [--semilla N] [--repeticiones N]" },
+    { "compilar", RunCompileCommand, "compilar <texto> <binario>" },
+    { "arranque", RunStartupCommand, "arranque [--cuerpos N]" },
+    { "mapeo", RunMappedStartupCommand, "mapeo [--fixtures N]" },
+    { "recarga", RunReloadCommand, "recarga [--cuerpos N]" },
+    { "estres", RunStressCommand, "estres <tipo|todas> [--cuerpos N] [--semilla N] [--pasos N] [--escala]" },
+    { "lote", RunBatchCommand, "lote [--mundos N] [--pasos N] [--hilos N]" },
+    { "barrido", RunSweepCommand, "barrido <escena> [--restitucion a:b:n] [--friccion a:b:n] [--densidad a:b:n] [--gravedad a:b:n] [--pasos N] [--hilos N] [--salida archivo] [--continuar]" },
+    { "tareas", RunJobCommand, "tareas [--hilos N] [--tareas N] [--rayos N]" },
+    { "particulas", RunParticleCommand, "particulas [--cantidad N] [--frames N]" },
+    { "rendimiento", RunBenchCommand, "rendimiento [--filtro texto] [--muestras N] [--escala N] [--pasos N] [--salida archivo]" },
+    { "regresion", RunRegressionCommand, "regresion [--muestras N] [--escala N] [--pasos N] [--nucleo N] [--salida archivo]" },
+    { "comparar", RunCompareCommand, "comparar <base> <nuevo> [--umbral P] [--umbral-para prefijo=P] [--ruido K]" },
+    { "asignaciones", RunAllocCommand, "asignaciones [escena|todas] [--calentamiento N] [--frames N]" },
+};
+
+// Muestra la lista de comandos
+static void PrintUsage()
+{
+    std::cout << "Uso: Herramientas <comando> [opciones]\n";
+    for (const Command& command : commands)
+        std::cout << "  " << command.usage << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    // Buscar el comando y pasarle el resto de los argumentos
+    for (const Command& command : commands)
+    {
+        if (std::strcmp(argv[1], command.name) == 0)
+            return command.run(argc - 2, argv + 2);
+    }
+
+    std::cout << "Comando desconocido: " << argv[1] << "\n";
+    PrintUsage();
+    return 2;
+}
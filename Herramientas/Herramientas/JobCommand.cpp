@@ -0,0 +1,122 @@
+#include "Commands.h"
+#include "Box2DHelper.h"
+#include "JobSystem.h"
+#include "ParallelQuery.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Costo de crear, encolar, ejecutar y esperar tareas vacias, en tandas
+// como las de un frame. Devuelve nanosegundos por tarea
+static double MeasureOverhead(JobSystem& jobs, int taskCount)
+{
+    const int batch = JobSystem::JobsPerThread / 2;
+    auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < taskCount; done += batch)
+    {
+        Job* root = jobs.Create(nullptr);
+        int count = b2Min(batch, taskCount - done);
+        for (int i = 0; i < count; ++i)
+            jobs.Run(jobs.Create([] {}, root));
+        jobs.Run(root);
+        jobs.Wait(root);
+    }
+    return ElapsedMs(start) * 1.0e6 / taskCount;
+}
+
+// tareas [--hilos N] [--tareas N] [--rayos N]
+// Mide el sistema de tareas con 1, 2, 4, ... hasta N hilos: el costo por
+// tarea vacia y como escala un lote de rayos repartido en tareas, contra
+// el mismo lote en el pool de hilos
+int RunJobCommand(int argc, char* argv[])
+{
+    int maxThreads = 16;
+    int tasks = 200000;
+    int rays = 100000;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--hilos") == 0 && i + 1 < argc)
+            maxThreads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--tareas") == 0 && i + 1 < argc)
+            tasks = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--rayos") == 0 && i + 1 < argc)
+            rays = std::atoi(argv[++i]);
+    }
+    if (tasks < 1)
+        tasks = 1;
+
+    // Mundo de 500 x 500 m con 5000 cajas sueltas y rayos de 30 m
+    const float size = 500.0f;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0.0f, size);
+    std::uniform_real_distribution<float> extent(0.5f, 3.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * b2_pi);
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
+    for (int i = 0; i < 5000; ++i)
+    {
+        b2Body* body = Box2DHelper::CreateRectangularDynamicBody(phyWorld, extent(rng), extent(rng), 1.0f, 0.5f, 0.1f);
+        body->SetTransform(b2Vec2(coord(rng), coord(rng)), 0.0f);
+    }
+    std::vector<b2Vec2> from(rays);
+    std::vector<b2Vec2> to(rays);
+    for (int i = 0; i < rays; ++i)
+    {
+        float a = angle(rng);
+        from[i].Set(coord(rng), coord(rng));
+        to[i] = from[i] + 30.0f * b2Vec2(std::cos(a), std::sin(a));
+    }
+
+    std::printf("%d tareas vacias, %d rayos, %u nucleos\n", tasks, rays, std::thread::hardware_concurrency());
+    std::printf("hilos  ns/tarea  robadas   rayos tareas  acel.   rayos pool  acel.\n");
+    double firstJobsMs = 0.0;
+    double firstPoolMs = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        double overhead;
+        double jobsMs;
+        JobStats stats;
+        {
+            JobSystem jobs(threads - 1);
+            MeasureOverhead(jobs, b2Min(tasks, 10000)); // Calentar los hilos
+            jobs.ResetStats();
+            overhead = MeasureOverhead(jobs, tasks);
+            stats = jobs.GetStats();
+
+            ParallelQuery query(phyWorld, &jobs);
+            query.RayCastClosest(from.data(), to.data(), rays);
+            auto start = std::chrono::steady_clock::now();
+            query.RayCastClosest(from.data(), to.data(), rays);
+            jobsMs = ElapsedMs(start);
+        }
+
+        double poolMs;
+        {
+            ThreadPool pool(threads - 1);
+            ParallelQuery query(phyWorld, &pool);
+            query.RayCastClosest(from.data(), to.data(), rays);
+            auto start = std::chrono::steady_clock::now();
+            query.RayCastClosest(from.data(), to.data(), rays);
+            poolMs = ElapsedMs(start);
+        }
+
+        if (threads == 1)
+        {
+            firstJobsMs = jobsMs;
+            firstPoolMs = poolMs;
+        }
+        std::printf("%5d  %8.1f  %6.1f%%  %9.2f ms  %5.2fx  %8.2f ms  %5.2fx\n", threads, overhead,
+            stats.executed > 0 ? 100.0 * stats.stolen / stats.executed : 0.0, jobsMs, firstJobsMs / jobsMs,
+            poolMs, firstPoolMs / poolMs);
+    }
+    delete phyWorld;
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Commands.h"
+#include "ParticleSystem.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Llena el sistema con count partculas de vida repartida en [0, lifeSpan):
+// a lo largo de la corrida se van venciendo y se reponen de a tandas
+static void Fill(ParticleSystem& particles, int count, float lifeSpan)
+{
+    particles.Clear();
+    particles.SpawnBurst(b2Vec2(0.0f, 0.0f), -0.5f * b2_pi, b2_pi, 5.0f, 50.0f, count, lifeSpan, sf::Color::White);
+}
+
+// particulas [--cantidad N] [--frames N]
+// Mide cada ncleo de integracin con N partculas: integrar, descartar
+// las vencidas y armar el arreglo de vrtices, en un solo hilo
+int RunParticleCommand(int argc, char* argv[])
+{
+    int count = 1000000;
+    int frames = 300;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--cantidad") == 0 && i + 1 < argc)
+            count = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frames = std::atoi(argv[++i]);
+    }
+    if (count < 1)
+        count = 1;
+    if (frames < 1)
+        frames = 1;
+
+    const float timeStep = 1.0f / 60.0f;
+    const b2Vec2 gravity(0.0f, 9.8f);
+    const float lifeSpan = 2.0f;
+    ParticleSystem particles(count);
+
+    std::printf("%d particulas, %d frames, un hilo\n", count, frames);
+    for (int k = 0; k < Kernel_Count; ++k)
+    {
+        ParticleKernel kernel = (ParticleKernel)k;
+        if (!particles.SetKernel(kernel))
+        {
+            std::printf("%-8s no lo soporta este procesador\n", ParticleSystem::GetKernelName(kernel));
+            continue;
+        }
+
+        Fill(particles, count, lifeSpan);
+        particles.Update(timeStep, gravity); // Primer frame: que el arreglo de vrtices llegue a su tamao
+
+        double totalMs = 0.0;
+        double worstMs = 0.0;
+        long long updated = 0;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            // Reponer las vencidas fuera de la medicin
+            if (particles.GetCount() < count / 2)
+                particles.SpawnBurst(b2Vec2(0.0f, 0.0f), -0.5f * b2_pi, b2_pi, 5.0f, 50.0f,
+                    count - particles.GetCount(), lifeSpan, sf::Color::White);
+
+            updated += particles.GetCount();
+            auto start = std::chrono::steady_clock::now();
+            particles.Update(timeStep, gravity);
+            double ms = ElapsedMs(start);
+            totalMs += ms;
+            worstMs = b2Max(worstMs, ms);
+        }
+        std::printf("%-8s %8.3f ms/frame  peor %8.3f ms  %7.2f ns/particula  %6.1f M particulas/s\n",
+            ParticleSystem::GetKernelName(kernel), totalMs / frames, worstMs, totalMs * 1.0e6 / updated,
+            updated / totalMs / 1000.0);
+    }
+    return 0;
+}
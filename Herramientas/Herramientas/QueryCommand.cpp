@@ -0,0 +1,164 @@
+#include "Commands.h"
+#include "Box2DHelper.h"
+#include "ParallelQuery.h"
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Forma "ingenua" de consultar: un callback en el heap y un vector nuevo
+// por consulta. Es la referencia contra la que se compara SpatialQuery
+class CollectCallback : public b2QueryCallback
+{
+public:
+    std::vector<b2Fixture*> found;
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        found.push_back(fixture);
+        return true;
+    }
+};
+
+class ClosestRayCallback : public b2RayCastCallback
+{
+public:
+    b2Fixture* fixture = nullptr;
+    float ReportFixture(b2Fixture* hit, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+    {
+        fixture = hit;
+        return fraction;
+    }
+};
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void PrintRow(const char* label, int queries, double ms, long long results)
+{
+    std::printf("%-22s %8.2f ms  %8.3f us/consulta  %10.0f consultas/s  resultados %lld\n",
+        label, ms, 1000.0 * ms / queries, queries / (ms / 1000.0), results);
+}
+
+// Corre una variante una vez sin medir (cache, arreglos en su tamao final)
+// y despus repeats veces; imprime la mediana. Todas las variantes pasan
+// por ac, as la comparacin no favorece a ninguna
+template <typename Run>
+static void MeasureRow(const char* label, int queries, int repeats, Run run)
+{
+    long long results = run();
+    std::vector<double> samples(repeats);
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        results = run();
+        samples[r] = ElapsedMs(start);
+    }
+    std::sort(samples.begin(), samples.end());
+    PrintRow(label, queries, samples[repeats / 2], results);
+}
+
+// consultas [--cuerpos N] [--consultas N] [--semilla N] [--repeticiones N]
+// Mide las consultas en lote contra callbacks creados por consulta. Cada
+// fila es la mediana de las repeticiones, despus de una pasada previa
+int RunQueryCommand(int argc, char* argv[])
+{
+    int bodies = 5000;
+    int queries = 10000;
+    unsigned int seed = 1;
+    int repeats = 5;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--cuerpos") == 0 && i + 1 < argc)
+            bodies = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--consultas") == 0 && i + 1 < argc)
+            queries = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--semilla") == 0 && i + 1 < argc)
+            seed = (unsigned int)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--repeticiones") == 0 && i + 1 < argc)
+            repeats = std::atoi(argv[++i]);
+    }
+    if (repeats < 1)
+        repeats = 1;
+
+    // Mundo de 500 x 500 m con cajas y circulos sueltos, sin gravedad
+    const float size = 500.0f;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, size);
+    std::uniform_real_distribution<float> extent(0.5f, 3.0f);
+
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
+    for (int i = 0; i < bodies; ++i)
+    {
+        b2Body* body;
+        if (i % 2 == 0)
+            body = Box2DHelper::CreateRectangularDynamicBody(phyWorld, extent(rng), extent(rng), 1.0f, 0.5f, 0.1f);
+        else
+            body = Box2DHelper::CreateCircularDynamicBody(phyWorld, extent(rng), 1.0f, 0.5f, 0.1f);
+        body->SetTransform(b2Vec2(coord(rng), coord(rng)), 0.0f);
+    }
+
+    // Consultas: cajas de 10 m, puntos y rayos de 30 m
+    std::vector<b2AABB> boxes(queries);
+    std::vector<b2Vec2> points(queries);
+    std::vector<b2Vec2> from(queries);
+    std::vector<b2Vec2> to(queries);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * b2_pi);
+    for (int i = 0; i < queries; ++i)
+    {
+        b2Vec2 center(coord(rng), coord(rng));
+        boxes[i].lowerBound = center - b2Vec2(5.0f, 5.0f);
+        boxes[i].upperBound = center + b2Vec2(5.0f, 5.0f);
+        points[i].Set(coord(rng), coord(rng));
+        float a = angle(rng);
+        from[i].Set(coord(rng), coord(rng));
+        to[i] = from[i] + 30.0f * b2Vec2(std::cos(a), std::sin(a));
+    }
+
+    ThreadPool pool;
+    std::printf("%d cuerpos, %d consultas de cada tipo, %d hilos\n", bodies, queries, pool.GetThreadCount());
+    SpatialQuery spatial(phyWorld);
+    ParallelQuery parallel(phyWorld, &pool);
+
+    // Cajas
+    MeasureRow("cajas, por consulta", queries, repeats, [&] {
+        long long found = 0;
+        for (int i = 0; i < queries; ++i)
+        {
+            CollectCallback* callback = new CollectCallback();
+            phyWorld->QueryAABB(callback, boxes[i]);
+            found += (long long)callback->found.size();
+            delete callback;
+        }
+        return found;
+    });
+    MeasureRow("cajas, en lote", queries, repeats, [&] { return (long long)spatial.QueryAABBs(boxes.data(), queries); });
+    MeasureRow("cajas, en paralelo", queries, repeats, [&] { return (long long)parallel.QueryAABBs(boxes.data(), queries); });
+
+    // Puntos
+    MeasureRow("puntos, en lote", queries, repeats, [&] { return (long long)spatial.QueryPoints(points.data(), queries); });
+
+    // Rayos
+    MeasureRow("rayos, por consulta", queries, repeats, [&] {
+        long long hits = 0;
+        for (int i = 0; i < queries; ++i)
+        {
+            ClosestRayCallback* callback = new ClosestRayCallback();
+            phyWorld->RayCast(callback, from[i], to[i]);
+            hits += callback->fixture ? 1 : 0;
+            delete callback;
+        }
+        return hits;
+    });
+    MeasureRow("rayos, en lote", queries, repeats, [&] { return (long long)spatial.RayCastClosest(from.data(), to.data(), queries); });
+    MeasureRow("rayos, en paralelo", queries, repeats, [&] { return (long long)parallel.RayCastClosest(from.data(), to.data(), queries); });
+
+    delete phyWorld;
+    return 0;
+}
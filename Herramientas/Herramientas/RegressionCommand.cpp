@@ -0,0 +1,181 @@
+#include "Commands.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Pasa la MAD a una desviacin estndar equivalente (si el ruido fuera normal)
+static const double madToSigma = 1.4826;
+
+// regresion [--muestras N] [--escala N] [--pasos N] [--nucleo N] [--salida archivo]
+// Corridas fijas sin ventana del paso de cada escena (las mediciones
+// "escena/" de rendimiento), con el hilo fijo a un ncleo y muchas
+// muestras para que comparar tenga con qu estimar el ruido
+int RunRegressionCommand(int argc, char* argv[])
+{
+    int samples = 15;
+    int scale = 16;
+    int steps = 600;
+    int core = 0;
+    const char* outputPath = "regresion.json";
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--muestras") == 0 && i + 1 < argc)
+            samples = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--escala") == 0 && i + 1 < argc)
+            scale = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--nucleo") == 0 && i + 1 < argc)
+            core = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--salida") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+    }
+    if (steps < 1)
+        steps = 1;
+
+    if (PinCurrentThread(core))
+        std::printf("Hilo fijo al nucleo %d\n", core);
+    else
+        std::printf("No se pudo fijar el hilo al nucleo %d; las muestras van a tener mas ruido\n", core);
+
+    BenchmarkRunner runner("escena/", samples);
+    RunSceneBenchmarks(runner, scale, steps);
+    if (!runner.WriteJson(outputPath))
+    {
+        std::printf("No se pudo escribir %s\n", outputPath);
+        return 1;
+    }
+    std::printf("%d escenas en %s\n", (int)runner.GetResults().size(), outputPath);
+    return 0;
+}
+
+// Umbral para un nombre: el del prefijo ms largo que coincide, si no el general
+struct ThresholdOverride
+{
+    std::string prefix;
+    double percent;
+};
+
+static double GetThreshold(const std::string& name, const std::vector<ThresholdOverride>& overrides, double defaultPercent)
+{
+    double percent = defaultPercent;
+    size_t longest = 0;
+    for (const ThresholdOverride& entry : overrides)
+    {
+        if (name.compare(0, entry.prefix.size(), entry.prefix) == 0 && entry.prefix.size() >= longest)
+        {
+            percent = entry.percent;
+            longest = entry.prefix.size();
+        }
+    }
+    return percent;
+}
+
+static const BenchmarkResult* FindResult(const std::vector<BenchmarkResult>& results, const std::string& name)
+{
+    for (const BenchmarkResult& result : results)
+    {
+        if (result.name == name)
+            return &result;
+    }
+    return nullptr;
+}
+
+// comparar <base> <nuevo> [--umbral P] [--umbral-para prefijo=P] [--ruido K]
+// Compara dos salidas de rendimiento o regresion por mediana. Una medicin
+// empeor si la mediana subi ms de P% (5 por defecto) y adems ms de
+// K (3 por defecto) veces el ruido de las muestras, estimado con la MAD.
+// Sale con 1 si alguna empeor
+int RunCompareCommand(int argc, char* argv[])
+{
+    const char* paths[2] = { nullptr, nullptr };
+    int pathCount = 0;
+    double threshold = 5.0;
+    double noiseFactor = 3.0;
+    std::vector<ThresholdOverride> overrides;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--umbral") == 0 && i + 1 < argc)
+            threshold = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--ruido") == 0 && i + 1 < argc)
+            noiseFactor = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--umbral-para") == 0 && i + 1 < argc)
+        {
+            const char* spec = argv[++i];
+            const char* equals = std::strrchr(spec, '=');
+            if (!equals)
+            {
+                std::printf("--umbral-para espera prefijo=porcentaje: %s\n", spec);
+                return 2;
+            }
+            ThresholdOverride entry;
+            entry.prefix.assign(spec, equals - spec);
+            entry.percent = std::atof(equals + 1);
+            overrides.push_back(entry);
+        }
+        else if (pathCount < 2)
+            paths[pathCount++] = argv[i];
+    }
+    if (pathCount < 2)
+    {
+        std::printf("Faltan archivos: comparar <base> <nuevo>\n");
+        return 2;
+    }
+
+    std::vector<BenchmarkResult> base;
+    std::vector<BenchmarkResult> current;
+    std::string error;
+    if (!BenchmarkRunner::ReadJson(paths[0], base, error) || !BenchmarkRunner::ReadJson(paths[1], current, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 2;
+    }
+
+    int regressions = 0;
+    int improvements = 0;
+    std::printf("%-44s %12s %12s %8s %10s  %s\n", "medicion", "base ns", "nuevo ns", "cambio", "ruido ns", "estado");
+    for (const BenchmarkResult& before : base)
+    {
+        const BenchmarkResult* after = FindResult(current, before.name);
+        if (!after)
+        {
+            std::printf("%-44s %12.1f %12s %8s %10s  falta en %s\n", before.name.c_str(), before.GetMedian(), "-", "-", "-", paths[1]);
+            continue;
+        }
+
+        double baseMedian = before.GetMedian();
+        double newMedian = after->GetMedian();
+        double change = baseMedian > 0.0 ? 100.0 * (newMedian - baseMedian) / baseMedian : 0.0;
+        double noise = noiseFactor * madToSigma * std::max(before.GetMad(), after->GetMad());
+        double percent = GetThreshold(before.name, overrides, threshold);
+
+        const char* status = "igual";
+        if (change > percent && newMedian - baseMedian > noise)
+        {
+            status = "EMPEORO";
+            regressions++;
+        }
+        else if (change < -percent && baseMedian - newMedian > noise)
+        {
+            status = "mejoro";
+            improvements++;
+        }
+        else if (change > percent || change < -percent)
+            status = "dentro del ruido";
+
+        std::printf("%-44s %12.1f %12.1f %+7.1f%% %10.1f  %s%s\n", before.name.c_str(), baseMedian, newMedian, change, noise, status,
+            before.samples.size() < 5 || after->samples.size() < 5 ? " (pocas muestras)" : "");
+    }
+    for (const BenchmarkResult& after : current)
+    {
+        if (!FindResult(base, after.name))
+            std::printf("%-44s %12s %12.1f %8s %10s  nueva\n", after.name.c_str(), "-", after.GetMedian(), "-", "-");
+    }
+
+    std::printf("%d empeoraron, %d mejoraron (umbral %.1f%%, ruido %.1f x MAD)\n", regressions, improvements, threshold, noiseFactor);
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,341 @@
+#include "Commands.h"
+#include "SceneFile.h"
+#include "SceneReloader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// compilar <texto> <binario>
+// Pasa una escena de texto a la forma binaria
+int RunCompileCommand(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Uso: compilar <texto> <binario>\n");
+        return 2;
+    }
+
+    SceneData data;
+    std::string error;
+    if (!SceneFile::LoadText(argv[0], data, error) || !SceneFile::SaveBinary(argv[1], data, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s: %d cuerpos, %d fixtures\n", argv[1], (int)data.bodies.size(), (int)data.fixtures.size());
+    return 0;
+}
+
+// Escena de prueba: suelo, paredes y una grilla de cajas y circulos
+static void MakeGridScene(int bodies, SceneData& data)
+{
+    data.Clear();
+
+    SceneFixture wall = {};
+    wall.shape = SceneShape_Box;
+    wall.friction = 0.5f;
+    SceneBody ground = {};
+    ground.type = b2_staticBody;
+    ground.layer = -1;
+    ground.fixtureCount = 1;
+
+    int columns = 1;
+    while (columns * columns < bodies)
+        columns++;
+    float size = columns * 2.0f;
+
+    wall.width = size + 20.0f;
+    wall.height = 10.0f;
+    ground.firstFixture = (int32)data.fixtures.size();
+    ground.position.Set(size / 2.0f, size + 5.0f);
+    data.fixtures.push_back(wall);
+    data.bodies.push_back(ground);
+
+    SceneFixture box = {};
+    box.shape = SceneShape_Box;
+    box.density = 1.0f;
+    box.friction = 0.3f;
+    box.width = 1.5f;
+    box.height = 1.5f;
+    SceneFixture ball = box;
+    ball.shape = SceneShape_Circle;
+    ball.radius = 0.75f;
+
+    for (int i = 0; i < bodies; ++i)
+    {
+        SceneBody body = {};
+        body.type = b2_dynamicBody;
+        body.layer = -1;
+        body.firstFixture = (int32)data.fixtures.size();
+        body.fixtureCount = 1;
+        body.position.Set((i % columns) * 2.0f + 1.0f, (i / columns) * 2.0f + 1.0f);
+        data.fixtures.push_back(i % 2 == 0 ? box : ball);
+        data.bodies.push_back(body);
+    }
+    data.controlBody = 1;
+}
+
+// Mide lectura de texto, lectura binaria y armado del mundo
+static void MeasureStartup(int bodies)
+{
+    SceneData source;
+    MakeGridScene(bodies, source);
+
+    std::string error;
+    const char* textPath = "arranque_prueba.txt";
+    const char* binaryPath = "arranque_prueba.bin";
+    if (!SceneFile::SaveText(textPath, source, error) || !SceneFile::SaveBinary(binaryPath, source, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return;
+    }
+
+    SceneData data;
+    auto start = std::chrono::steady_clock::now();
+    SceneFile::LoadText(textPath, data, error);
+    double textMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    SceneFile::LoadBinary(binaryPath, data, error);
+    double binaryMs = ElapsedMs(start);
+
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    start = std::chrono::steady_clock::now();
+    SceneFile::Build(data, phyWorld);
+    double buildMs = ElapsedMs(start);
+    delete phyWorld;
+
+    std::printf("%7d cuerpos  texto %9.2f ms  binario %8.2f ms  armado %9.2f ms  arranque: texto %9.2f ms, binario %9.2f ms\n",
+        bodies + 1, textMs, binaryMs, buildMs, textMs + buildMs, binaryMs + buildMs);
+
+    std::remove(textPath);
+    std::remove(binaryPath);
+}
+
+// arranque [--cuerpos N]
+// Tiempo de arranque de una escena chica y de una grande (100000 cuerpos por defecto)
+int RunStartupCommand(int argc, char* argv[])
+{
+    int bodies = 100000;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--cuerpos") == 0 && i + 1 < argc)
+            bodies = std::atoi(argv[++i]);
+    }
+
+    MeasureStartup(10);
+    MeasureStartup(bodies);
+    return 0;
+}
+
+// Saca el archivo de la cache de paginas del sistema para que la proxima
+// lectura vaya al disco. En Windows no hay una llamada equivalente sin
+// privilegios: ahi "frio" es solo el primer mapeo despues de escribirlo
+static bool EvictFromCache(const char* path)
+{
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    fdatasync(fd);
+    bool ok = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+
+// Lectura con fread a un SceneData y armado
+static double MeasureCopyLoad(const char* path)
+{
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    auto start = std::chrono::steady_clock::now();
+    SceneData data;
+    std::string error;
+    if (SceneFile::LoadBinary(path, data, error))
+        SceneFile::Build(data, phyWorld);
+    else
+        std::printf("%s\n", error.c_str());
+    double ms = ElapsedMs(start);
+    delete phyWorld;
+    return ms;
+}
+
+// Mapeo y armado leyendo en el lugar. Las paginas se traen durante Build()
+static double MeasureMappedLoad(const char* path, double& mapMs)
+{
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    SceneView view;
+    std::string error;
+    if (SceneFile::MapBinary(path, file, view, error))
+    {
+        mapMs = ElapsedMs(start);
+        SceneFile::Build(view, phyWorld);
+    }
+    else
+        std::printf("%s\n", error.c_str());
+    file.Close();
+    double ms = ElapsedMs(start);
+    delete phyWorld;
+    return ms;
+}
+
+// mapeo [--fixtures N]
+// Arranque de una escena binaria grande (200000 fixtures por defecto) leida
+// con fread o mapeada, en frio (fuera de la cache) y en caliente
+int RunMappedStartupCommand(int argc, char* argv[])
+{
+    int fixtures = 200000;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--fixtures") == 0 && i + 1 < argc)
+            fixtures = std::atoi(argv[++i]);
+    }
+
+    // La grilla tiene una fixture por cuerpo mas el suelo
+    SceneData source;
+    MakeGridScene(fixtures > 1 ? fixtures - 1 : 1, source);
+    const char* path = "mapeo_prueba.bin";
+    std::string error;
+    if (!SceneFile::SaveBinary(path, source, error))
+    {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s: %d cuerpos, %d fixtures, %.1f MB\n", path, (int)source.bodies.size(), (int)source.fixtures.size(),
+        (sizeof(SceneFileHeader) + source.bodies.size() * sizeof(SceneBody) + source.fixtures.size() * sizeof(SceneFixture)) / (1024.0 * 1024.0));
+
+    bool evicted = EvictFromCache(path);
+    double copyCold = MeasureCopyLoad(path);
+    EvictFromCache(path);
+    double mapCold = 0.0;
+    double mappedCold = MeasureMappedLoad(path, mapCold);
+
+    double copyWarm = MeasureCopyLoad(path);
+    double mapWarm = 0.0;
+    double mappedWarm = MeasureMappedLoad(path, mapWarm);
+
+    if (!evicted)
+        std::printf("(no se pudo sacar el archivo de la cache: la medicion en frio no toca el disco)\n");
+    std::printf("frio:     fread + armado %9.2f ms  mapeo + armado %9.2f ms (mapeo %.3f ms)\n", copyCold, mappedCold, mapCold);
+    std::printf("caliente: fread + armado %9.2f ms  mapeo + armado %9.2f ms (mapeo %.3f ms)\n", copyWarm, mappedWarm, mapWarm);
+
+    std::remove(path);
+    return 0;
+}
+
+// Ediciones de prueba para la recarga: cada una toca uno de cada step cuerpos
+static void EditMaterial(SceneData& data, int step)
+{
+    for (size_t i = 1; i < data.bodies.size(); i += step)
+        data.fixtures[data.bodies[i].firstFixture].friction += 0.1f;
+}
+
+static void EditPosition(SceneData& data, int step)
+{
+    for (size_t i = 1; i < data.bodies.size(); i += step)
+        data.bodies[i].position.y -= 1.0f;
+}
+
+static void EditShape(SceneData& data, int step)
+{
+    for (size_t i = 1; i < data.bodies.size(); i += step)
+    {
+        SceneFixture& fixture = data.fixtures[data.bodies[i].firstFixture];
+        fixture.width += 0.25f;
+        fixture.radius += 0.125f;
+    }
+}
+
+static void EditAdd(SceneData& data, int step)
+{
+    int count = (int)data.bodies.size() / step;
+    for (int i = 0; i < count; ++i)
+    {
+        SceneBody body = data.bodies.back();
+        SceneFixture fixture = data.fixtures[body.firstFixture];
+        body.firstFixture = (int32)data.fixtures.size();
+        body.position.y -= 2.0f;
+        data.fixtures.push_back(fixture);
+        data.bodies.push_back(body);
+    }
+}
+
+// La grilla agrega cuerpo y fixture juntos: los ultimos son los del final
+static void EditRemove(SceneData& data, int step)
+{
+    int count = (int)data.bodies.size() / step;
+    for (int i = 0; i < count && data.bodies.size() > 2; ++i)
+    {
+        data.bodies.pop_back();
+        data.fixtures.pop_back();
+    }
+}
+
+// recarga [--cuerpos N]
+// Latencia de aplicar ediciones chicas (1% de los cuerpos) a una escena
+// grande comparada con volver a armarla entera
+int RunReloadCommand(int argc, char* argv[])
+{
+    int bodies = 100000;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--cuerpos") == 0 && i + 1 < argc)
+            bodies = std::atoi(argv[++i]);
+    }
+    int step = 100;
+
+    SceneData data;
+    MakeGridScene(bodies, data);
+
+    b2World* phyWorld = new b2World(data.gravity);
+    std::vector<b2Body*> created;
+    auto start = std::chrono::steady_clock::now();
+    SceneFile::Build(data, phyWorld, &created);
+    double buildMs = ElapsedMs(start);
+
+    // Sin archivo: solo se usa Apply
+    SceneReloader reloader;
+    reloader.Watch("", data, created);
+
+    struct SceneEdit
+    {
+        const char* name;
+        void (*apply)(SceneData& data, int step);
+    };
+    const SceneEdit edits[] = {
+        { "material", EditMaterial },
+        { "posicion", EditPosition },
+        { "forma", EditShape },
+        { "agregar", EditAdd },
+        { "quitar", EditRemove },
+    };
+
+    std::printf("%d cuerpos, armado completo %.2f ms\n", (int)data.bodies.size(), buildMs);
+    for (const SceneEdit& sceneEdit : edits)
+    {
+        sceneEdit.apply(data, step);
+        SceneReloadStats stats;
+        reloader.Apply(data, phyWorld, stats);
+        std::printf("%-10s %6d nuevos %6d borrados %6d rehechos %6d modificados  %9.2f ms\n", sceneEdit.name,
+            stats.created, stats.destroyed, stats.rebuilt, stats.patched, stats.applyMs);
+    }
+
+    delete phyWorld;
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "Commands.h"
+#include "StressScenes.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Huella (FNV-1a) de las posiciones y angulos de todos los cuerpos: dos
+// corridas con la misma semilla y el mismo ejecutable dan la misma
+static uint32 Fingerprint(b2World* phyWorld)
+{
+    uint32 hash = 2166136261u;
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        float values[3] = { body->GetPosition().x, body->GetPosition().y, body->GetAngle() };
+        const unsigned char* bytes = (const unsigned char*)values;
+        for (size_t i = 0; i < sizeof(values); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+// Arma la escena, la simula y muestra tiempos de armado y de paso
+static void RunStressScene(const StressParams& params, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    b2World* phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+
+    auto start = std::chrono::steady_clock::now();
+    StressSceneInfo info = StressScenes::Build(phyWorld, params);
+    double buildMs = ElapsedMs(start);
+
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    for (int i = 0; i < steps; ++i)
+    {
+        start = std::chrono::steady_clock::now();
+        phyWorld->Step(timeStep, 8, 8);
+        double stepMs = ElapsedMs(start);
+        totalMs += stepMs;
+        worstMs = b2Max(worstMs, stepMs);
+    }
+
+    std::printf("%-10s %8d dinamicos %7d fijos  armado %9.2f ms  paso medio %9.3f ms  peor %9.3f ms  contactos %8d  huella %08x\n",
+        StressScenes::GetName(params.kind), info.dynamicCount, info.staticCount, buildMs,
+        steps > 0 ? totalMs / steps : 0.0, worstMs, phyWorld->GetContactCount(), Fingerprint(phyWorld));
+    delete phyWorld;
+}
+
+// estres <tipo|todas> [--cuerpos N] [--semilla N] [--pasos N] [--escala]
+// Escenas generadas para ver como escala el paso con la cantidad de
+// cuerpos. --escala repite con 100, 1000, ... hasta 1000000 cuerpos
+int RunStressCommand(int argc, char* argv[])
+{
+    int bodies = 10000;
+    unsigned int seed = 1;
+    int steps = 120;
+    bool scale = false;
+    const char* kindName = "todas";
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--cuerpos") == 0 && i + 1 < argc)
+            bodies = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--semilla") == 0 && i + 1 < argc)
+            seed = (unsigned int)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--escala") == 0)
+            scale = true;
+        else
+            kindName = argv[i];
+    }
+
+    int firstKind = 0;
+    int lastKind = Stress_Count - 1;
+    if (std::strcmp(kindName, "todas") != 0)
+    {
+        StressKind kind;
+        if (!StressScenes::FromName(kindName, kind))
+        {
+            std::printf("Tipo desconocido: %s (piramide, obstaculos, pileta, rampas, balas o todas)\n", kindName);
+            return 2;
+        }
+        firstKind = lastKind = kind;
+    }
+
+    std::printf("Semilla %u, %d pasos\n", seed, steps);
+    for (int kind = firstKind; kind <= lastKind; ++kind)
+    {
+        if (!scale)
+        {
+            RunStressScene(StressParams((StressKind)kind, bodies, seed), steps);
+            continue;
+        }
+        for (int count = StressScenes::MinBodies; count <= StressScenes::MaxBodies; count *= 10)
+            RunStressScene(StressParams((StressKind)kind, count, seed), steps);
+    }
+    return 0;
+}
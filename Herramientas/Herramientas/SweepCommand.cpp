@@ -0,0 +1,293 @@
+#include "Commands.h"
+#include "BatchSimulator.h"
+#include "Scenes.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Parametros que se barren, en el orden de las columnas del CSV
+enum SweepParam
+{
+    Sweep_Restitution = 0,
+    Sweep_Friction,
+    Sweep_Density,
+    Sweep_Gravity,
+    Sweep_Count
+};
+
+static const char* sweepOptions[Sweep_Count] = { "--restitucion", "--friccion", "--densidad", "--gravedad" };
+static const char* sweepColumns[Sweep_Count] = { "restitucion", "friccion", "densidad", "gravedad" };
+
+// Grilla de un parametro: count valores entre min y max. Con count 0 el
+// parametro no se toca y queda el valor que pone la escena
+struct SweepRange
+{
+    float min;
+    float max;
+    int count;
+
+    float GetValue(int i) const
+    {
+        return count > 1 ? min + (max - min) * i / (count - 1) : min;
+    }
+};
+
+// Lee "min:max:n" o un valor solo
+static bool ParseRange(const char* text, SweepRange& range)
+{
+    float min, max;
+    int count;
+    if (std::sscanf(text, "%f:%f:%d", &min, &max, &count) == 3 && count > 0)
+    {
+        range.min = min;
+        range.max = max;
+        range.count = count;
+        return true;
+    }
+    if (std::sscanf(text, "%f", &min) == 1 && std::strchr(text, ':') == nullptr)
+    {
+        range.min = range.max = min;
+        range.count = 1;
+        return true;
+    }
+    return false;
+}
+
+// Valores de una combinacion; el indice recorre la grilla con la gravedad
+// como digito mas rapido
+static void GetCombination(const SweepRange ranges[Sweep_Count], int index, float values[Sweep_Count], bool used[Sweep_Count])
+{
+    for (int p = Sweep_Count - 1; p >= 0; --p)
+    {
+        used[p] = ranges[p].count > 0;
+        if (!used[p])
+            continue;
+        values[p] = ranges[p].GetValue(index % ranges[p].count);
+        index /= ranges[p].count;
+    }
+}
+
+// Pisa los materiales de la escena ya armada. Friccion y restitucion van
+// a todos los fixtures: Box2D combina las del par (media geometrica y
+// maximo), asi el contacto termina con el valor barrido
+static void ApplyCombination(b2World* phyWorld, const float values[Sweep_Count], const bool used[Sweep_Count])
+{
+    if (used[Sweep_Gravity])
+        phyWorld->SetGravity(b2Vec2(0.0f, values[Sweep_Gravity]));
+
+    for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+    {
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+        {
+            if (used[Sweep_Restitution])
+                fixture->SetRestitution(values[Sweep_Restitution]);
+            if (used[Sweep_Friction])
+                fixture->SetFriction(values[Sweep_Friction]);
+            if (used[Sweep_Density] && body->GetType() == b2_dynamicBody)
+                fixture->SetDensity(values[Sweep_Density]);
+        }
+        if (used[Sweep_Density] && body->GetType() == b2_dynamicBody)
+            body->ResetMassData();
+    }
+}
+
+// Primera linea del CSV: describe la corrida, para no continuar un
+// archivo hecho con otra escena u otra grilla
+static std::string DescribeRun(SceneId scene, const SweepRange ranges[Sweep_Count], int steps)
+{
+    char text[512];
+    int length = std::snprintf(text, sizeof(text), "# barrido %s pasos=%d", Scenes::GetName(scene), steps);
+    for (int p = 0; p < Sweep_Count; ++p)
+    {
+        if (ranges[p].count > 0)
+            length += std::snprintf(text + length, sizeof(text) - length, " %s=%g:%g:%d", sweepColumns[p],
+                ranges[p].min, ranges[p].max, ranges[p].count);
+    }
+    return text;
+}
+
+// Cuenta las filas completas de un CSV anterior. Si la ultima quedo a
+// medio escribir (se corto el proceso) se descarta reescribiendo el
+// archivo hasta el ultimo salto de linea. Devuelve -1 si no es de esta
+// corrida
+static int ReadCompletedRows(const char* path, const std::string& description)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file)
+        return 0;
+    std::string content;
+    char buffer[65536];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        content.append(buffer, read);
+    std::fclose(file);
+
+    size_t complete = content.rfind('\n');
+    complete = complete == std::string::npos ? 0 : complete + 1;
+    if (content.compare(0, description.size(), description) != 0 || content.size() <= description.size()
+        || content[description.size()] != '\n')
+        return -1;
+
+    // Dos lineas de encabezado (descripcion y columnas) y despues una fila
+    // por combinacion
+    int lines = 0;
+    for (size_t i = 0; i < complete; ++i)
+    {
+        if (content[i] == '\n')
+            lines++;
+    }
+    if (complete < content.size())
+    {
+        file = std::fopen(path, "wb");
+        if (!file)
+            return -1;
+        std::fwrite(content.data(), 1, complete, file);
+        std::fclose(file);
+    }
+    return lines >= 2 ? lines - 2 : -1;
+}
+
+// barrido <escena> [--restitucion a:b:n] [--friccion a:b:n] [--densidad a:b:n]
+//         [--gravedad a:b:n] [--pasos N] [--hilos N] [--salida archivo] [--continuar]
+// Simula sin ventana cada combinacion de la grilla sobre la escena de un
+// ejercicio, en paralelo, y guarda una fila por combinacion en un CSV.
+// Con --continuar retoma un archivo cortado desde la primera fila que falta
+int RunSweepCommand(int argc, char* argv[])
+{
+    SweepRange ranges[Sweep_Count] = {};
+    int steps = 1200;
+    int threads = 0;
+    bool resume = false;
+    const char* outputPath = "barrido.csv";
+    const char* sceneName = nullptr;
+    for (int i = 0; i < argc; ++i)
+    {
+        int param = -1;
+        for (int p = 0; p < Sweep_Count; ++p)
+        {
+            if (std::strcmp(argv[i], sweepOptions[p]) == 0)
+                param = p;
+        }
+        if (param >= 0 && i + 1 < argc)
+        {
+            if (!ParseRange(argv[++i], ranges[param]))
+            {
+                std::printf("Rango invalido para %s: %s (min:max:n o un valor)\n", sweepOptions[param], argv[i]);
+                return 2;
+            }
+        }
+        else if (std::strcmp(argv[i], "--pasos") == 0 && i + 1 < argc)
+            steps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--hilos") == 0 && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--salida") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (std::strcmp(argv[i], "--continuar") == 0)
+            resume = true;
+        else
+            sceneName = argv[i];
+    }
+
+    SceneId scene;
+    if (!sceneName || !Scenes::FromName(sceneName, scene))
+    {
+        std::printf("Escena desconocida: %s (ejercicio1 ... ejercicio4, act5, act6)\n", sceneName ? sceneName : "");
+        return 2;
+    }
+
+    int total = 1;
+    for (int p = 0; p < Sweep_Count; ++p)
+    {
+        if (ranges[p].count > 0)
+            total *= ranges[p].count;
+    }
+
+    std::string description = DescribeRun(scene, ranges, steps);
+    int done = 0;
+    if (resume)
+    {
+        done = ReadCompletedRows(outputPath, description);
+        if (done < 0)
+        {
+            std::printf("%s no es de este barrido; se deja como esta\n", outputPath);
+            return 2;
+        }
+    }
+
+    FILE* output = std::fopen(outputPath, done > 0 ? "ab" : "wb");
+    if (!output)
+    {
+        std::printf("No se pudo abrir %s\n", outputPath);
+        return 1;
+    }
+    if (done == 0)
+    {
+        std::fprintf(output, "%s\nindice,restitucion,friccion,densidad,gravedad,tiempo_reposo,velocidad_max,rebotes,desplazamiento,recorrido,pasos\n",
+            description.c_str());
+    }
+    else
+        std::printf("Continuando desde la combinacion %d de %d\n", done, total);
+
+    const float timeStep = 1.0f / 60.0f;
+    ThreadPool pool(threads > 0 ? threads - 1 : -1);
+    BatchSimulator simulator(&pool);
+
+    // Se simula por tandas y se escribe cada una al terminar: si el
+    // proceso se corta se pierde a lo sumo la tanda en curso
+    const int batchSize = 64 * pool.GetThreadCount();
+    auto start = std::chrono::steady_clock::now();
+    int firstDone = done;
+    while (done < total)
+    {
+        int offset = done;
+        int count = b2Min(batchSize, total - done);
+        BatchSetup setup = [&ranges, scene, offset](b2World* phyWorld, int job) {
+            float values[Sweep_Count];
+            bool used[Sweep_Count];
+            GetCombination(ranges, offset + job, values, used);
+            b2Body* body = Scenes::Build(scene, phyWorld);
+            ApplyCombination(phyWorld, values, used);
+            return body;
+        };
+        simulator.Run(count, setup, steps, timeStep, true);
+
+        for (int job = 0; job < count; ++job)
+        {
+            float values[Sweep_Count];
+            bool used[Sweep_Count];
+            GetCombination(ranges, offset + job, values, used);
+            const BatchResult& result = simulator.GetResult(job);
+
+            // Los parametros que no se barren quedan vacios en su columna
+            std::fprintf(output, "%d", offset + job);
+            for (int p = 0; p < Sweep_Count; ++p)
+            {
+                if (used[p])
+                    std::fprintf(output, ",%g", values[p]);
+                else
+                    std::fprintf(output, ",");
+            }
+            std::fprintf(output, ",%g,%g,%d,%g,%g,%d\n", result.sleepTime, result.maxSpeed, result.bounces,
+                (result.endPosition - result.startPosition).Length(), result.pathLength, result.steps);
+        }
+        std::fflush(output);
+        done += count;
+
+        double seconds = ElapsedMs(start) / 1000.0;
+        double rate = (done - firstDone) / seconds;
+        std::printf("\r%d/%d (%.1f%%)  %.0f combinaciones/s  faltan %.0f s   ", done, total, 100.0 * done / total,
+            rate, (total - done) / rate);
+        std::fflush(stdout);
+    }
+    std::fclose(output);
+
+    std::printf("\n%d combinaciones de %s en %s\n", total, Scenes::GetName(scene), outputPath);
+    return 0;
+}